@@ -0,0 +1,137 @@
+#include "prop/utility/property.h"
+#include "prop/utility/tracking_list.h"
+
+#include <catch2/catch_all.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+//Run with `Prop_benchmarks --reporter XML::out=benchmarks.xml` (or the JSON reporter) to get machine-readable results.
+
+static const std::size_t sizes[] = {1, 16, 256};
+
+TEST_CASE("Construction and destruction", "[Property][!benchmark]") {
+	BENCHMARK("Property<int>") {
+		prop::Property<int> p = 42;
+		return p.get();
+	};
+	BENCHMARK("Property<std::string>") {
+		prop::Property<std::string> p = "some text that does not fit into the small string buffer";
+		return std::size(p.get());
+	};
+	prop::Property source = 1;
+	BENCHMARK("bound Property<int>") {
+		prop::Property<int> p = [&source] { return source + 1; };
+		return p.get();
+	};
+}
+
+TEST_CASE("Write with dependents", "[Property][!benchmark]") {
+	for (auto dependent_count : sizes) {
+		prop::Property source = 0;
+		std::vector<std::unique_ptr<prop::Property<int>>> dependents;
+		for (std::size_t i = 0; i < dependent_count; i++) {
+			dependents.push_back(std::make_unique<prop::Property<int>>([&source] { return source + 1; }));
+		}
+		int value = 0;
+		BENCHMARK("write with " + std::to_string(dependent_count) + " dependents") {
+			source = ++value;
+		};
+		REQUIRE(*dependents.back() == value + 1);
+	}
+}
+
+TEST_CASE("Write through chain", "[Property][!benchmark]") {
+	for (auto depth : sizes) {
+		prop::Property source = 0;
+		std::vector<std::unique_ptr<prop::Property<int>>> chain;
+		for (std::size_t i = 0; i < depth; i++) {
+			auto &previous = chain.empty() ? source : *chain.back();
+			chain.push_back(std::make_unique<prop::Property<int>>([&previous] { return previous + 1; }));
+		}
+		int value = 0;
+		BENCHMARK("write through chain of depth " + std::to_string(depth)) {
+			source = ++value;
+		};
+		REQUIRE(*chain.back() == value + static_cast<int>(depth));
+	}
+}
+
+TEST_CASE("Write through diamonds", "[Property][!benchmark]") {
+	for (auto diamonds : sizes) {
+		//every diamond splits the previous tip into 2 properties and joins them again
+		prop::Property source = 0;
+		std::vector<std::unique_ptr<prop::Property<int>>> properties;
+		prop::Property<int> *tip = &source;
+		for (std::size_t i = 0; i < diamonds; i++) {
+			auto &left = *properties.emplace_back(std::make_unique<prop::Property<int>>([tip] { return *tip + 1; }));
+			auto &right = *properties.emplace_back(std::make_unique<prop::Property<int>>([tip] { return *tip - 1; }));
+			tip = properties
+					  .emplace_back(std::make_unique<prop::Property<int>>([&left, &right] { return (left + right) / 2; }))
+					  .get();
+		}
+		int value = 0;
+		BENCHMARK("write through " + std::to_string(diamonds) + " diamonds") {
+			source = ++value;
+		};
+		REQUIRE(*tip == value);
+	}
+}
+
+TEST_CASE("Implicit dependency capture", "[Property][!benchmark]") {
+	for (auto dependency_count : sizes) {
+		std::vector<prop::Property<int>> dependencies(dependency_count);
+		prop::Property<int> reader;
+		BENCHMARK("bind reading " + std::to_string(dependency_count) + " properties") {
+			reader = [&dependencies] {
+				int sum = 0;
+				for (auto &dependency : dependencies) {
+					sum += dependency;
+				}
+				return sum;
+			};
+		};
+		int value = 0;
+		BENCHMARK("update reading " + std::to_string(dependency_count) + " properties") {
+			dependencies.front() = ++value;
+		};
+		REQUIRE(reader == value);
+	}
+}
+
+TEST_CASE("Property_link move and swap", "[Property_link][!benchmark]") {
+	for (auto link_count : sizes) {
+		prop::Property source = 0;
+		prop::Property<int> p1 = [&source] { return source + 1; };
+		prop::Property<int> p2 = [&source] { return source + 2; };
+		std::vector<std::unique_ptr<prop::Property<int>>> dependents;
+		for (std::size_t i = 0; i < link_count; i++) {
+			dependents.push_back(std::make_unique<prop::Property<int>>([&p1, &p2] { return p1 + p2; }));
+		}
+		BENCHMARK("move with " + std::to_string(link_count) + " dependents") {
+			p2 = std::move(p1);
+			p1 = std::move(p2);
+		};
+		BENCHMARK("swap with " + std::to_string(link_count) + " dependents") {
+			swap(static_cast<prop::Property_link &>(p1), static_cast<prop::Property_link &>(p2));
+		};
+	}
+}
+
+TEST_CASE("Tracking_list iteration", "[Tracking_list][!benchmark]") {
+	for (auto tracked_count : sizes) {
+		prop::Property source = 0;
+		std::vector<std::unique_ptr<prop::Property<int>>> dependents;
+		for (std::size_t i = 0; i < tracked_count; i++) {
+			dependents.push_back(std::make_unique<prop::Property<int>>([&source] { return source + 1; }));
+		}
+		auto list = prop::Tracking_list<>::of_dependents(source);
+		BENCHMARK("iterate " + std::to_string(tracked_count) + " tracked properties") {
+			std::size_t alive = 0;
+			for (auto &p : list) {
+				alive += p != nullptr;
+			}
+			return alive;
+		};
+	}
+}
@@ -1,15 +1,16 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <string_view>
 #include <vector>
 
+#include "prop/utility/color.h"
 #include "prop/utility/rect.h"
 
 namespace prop {
 	class Window;
 	class Font;
-	class Color;
 
 	namespace platform {
 		class Window {
@@ -38,9 +39,23 @@ namespace prop {
 
 		struct Canvas_context;
 		namespace canvas {
+			struct Rect_outline {
+				prop::Rect<> rect;
+				prop::Color color;
+				float width_px;
+			};
+			struct Text_run {
+				prop::Rect<> rect;
+				std::string_view text;
+				prop::Color color;
+			};
+
 			void draw_text(Canvas_context &canvas_context, const prop::Rect<> &rect, std::string_view text,
 						   const Font &font);
 			void draw_rect(Canvas_context &canvas_context, prop::Rect<> rect, prop::Color color, float width_px);
+			//batched versions of draw_rect and draw_text, texts share font except for its color
+			void draw_rects(Canvas_context &canvas_context, std::span<const Rect_outline> rects);
+			void draw_texts(Canvas_context &canvas_context, std::span<const Text_run> texts, const Font &font);
 			int text_height(const prop::Font &font);
 			prop::Size<> text_size(std::string_view text, const Font &font);
 
@@ -68,6 +83,11 @@ namespace prop {
 		};
 		std::vector<Screen>
 		get_screens(Get_screens_strategy get_screens_strategy = Get_screens_strategy::compatibility);
+		//reads the screens again in the background, for example after a monitor was connected
+		//get_screens does not wait for it and returns the result of the last finished read
+		void refresh_screens();
+		//whether a refresh found different screens since the last call, the event loop then updates prop::screens
+		bool take_screens_changed();
 
 		//TODO: font dimensions
 	} // namespace platform
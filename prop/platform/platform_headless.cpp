@@ -0,0 +1,245 @@
+#include "platform_headless.h"
+#include "prop/ui/window.h"
+#include "prop/utility/draw_list.h"
+#include "prop/utility/font.h"
+#include "prop/utility/property_link.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+
+struct Headless_window;
+
+static std::vector<Headless_window *> headless_windows;
+
+namespace prop::platform {
+	struct Canvas_context {
+		headless::Framebuffer &framebuffer;
+		//nothing outside of clip is drawn
+		prop::Rect<int> clip;
+	};
+} // namespace prop::platform
+
+static std::uint32_t blend(std::uint32_t destination, prop::Color color) {
+	if (color.a == 255) {
+		return color.to_rgba();
+	}
+	const auto mix = [alpha = color.a](std::uint32_t source, std::uint32_t target) {
+		return (source * alpha + target * (255 - alpha)) / 255;
+	};
+	const auto r = mix(color.r, destination >> 24 & 0xff);
+	const auto g = mix(color.g, destination >> 16 & 0xff);
+	const auto b = mix(color.b, destination >> 8 & 0xff);
+	const auto a = color.a + (destination & 0xff) * (255 - color.a) / 255;
+	return r << 24 | g << 16 | b << 8 | a;
+}
+
+static void fill(prop::platform::Canvas_context &canvas_context, prop::Rect<int> rect, prop::Color color) {
+	auto &framebuffer = canvas_context.framebuffer;
+	const auto top = std::max({rect.top, canvas_context.clip.top, 0});
+	const auto left = std::max({rect.left, canvas_context.clip.left, 0});
+	const auto bottom = std::min({rect.bottom, canvas_context.clip.bottom, framebuffer.height});
+	const auto right = std::min({rect.right, canvas_context.clip.right, framebuffer.width});
+	for (int y = top; y < bottom; y++) {
+		const auto row = std::begin(framebuffer.pixels) + static_cast<std::ptrdiff_t>(y) * framebuffer.width;
+		for (int x = left; x < right; x++) {
+			row[x] = blend(row[x], color);
+		}
+	}
+}
+
+struct Headless_window : prop::platform::Window {
+	Headless_window(prop::Window *window_) {
+		window = window_;
+		headless_windows.push_back(this);
+	}
+	Headless_window(const Headless_window &) = delete;
+	~Headless_window() {
+		std::erase(headless_windows, this);
+	}
+	void render() {
+		prop::Graph_lock lock;
+		const prop::Rect<int> area{.bottom = window->size->height, .right = window->size->width};
+		bool outdated = false;
+		if (framebuffer.width != area.right or framebuffer.height != area.bottom) {
+			framebuffer.resize(area.right, area.bottom, prop::Color::white);
+			draw_list.clear();
+			outdated = true;
+		}
+		std::vector<prop::Rect<int>> dirty_regions;
+		if (auto &wp = window->widget.get()) {
+			dirty_regions = draw_list.update(*wp.get(), area);
+		} else {
+			draw_list.clear();
+		}
+		if (outdated) {
+			dirty_regions = {area};
+		}
+		for (const auto &region : dirty_regions) {
+			prop::platform::Canvas_context canvas_context{.framebuffer = framebuffer, .clip = region};
+			fill(canvas_context, region, prop::Color::white);
+			draw_list.replay(canvas_context, region);
+		}
+	}
+	prop::platform::headless::Framebuffer framebuffer;
+	prop::Draw_list draw_list;
+};
+
+prop::Color prop::platform::headless::Framebuffer::pixel(int x, int y) const {
+	return prop::Color{{.rgba = pixels[static_cast<std::size_t>(y * width + x)]}};
+}
+
+void prop::platform::headless::Framebuffer::resize(int width_, int height_, prop::Color color) {
+	width = std::max(width_, 0);
+	height = std::max(height_, 0);
+	pixels.assign(static_cast<std::size_t>(width) * static_cast<std::size_t>(height), color.to_rgba());
+}
+
+const prop::platform::headless::Framebuffer &prop::platform::headless::get_framebuffer(const prop::Window &window) {
+	return static_cast<const Headless_window &>(window.platform_window()).framebuffer;
+}
+
+void prop::platform::headless::write_ppm(const Framebuffer &framebuffer, std::ostream &os) {
+	os << "P6\n" << framebuffer.width << ' ' << framebuffer.height << "\n255\n";
+	for (auto pixel : framebuffer.pixels) {
+		const char rgb[] = {static_cast<char>(pixel >> 24 & 0xff), static_cast<char>(pixel >> 16 & 0xff),
+							static_cast<char>(pixel >> 8 & 0xff)};
+		os.write(rgb, sizeof rgb);
+	}
+}
+
+prop::Size<int> prop::platform::headless::glyph_size(const prop::Font &font) {
+	const auto height = std::max(1, static_cast<int>(std::lround(font.size.amount)));
+	return {.width = std::max(1, (height * 3 + 4) / 5), .height = height};
+}
+
+std::unique_ptr<prop::platform::Window, void (*)(prop::platform::Window *)>
+prop::platform::Window::create(prop::platform::Window::Params &&params) {
+	return std::unique_ptr<prop::platform::Window, void (*)(prop::platform::Window *)>{
+		new Headless_window(params.window),
+		[](prop::platform::Window *window_) { delete static_cast<Headless_window *>(window_); }};
+}
+
+void prop::platform::Window::pump() {
+	for (auto window : headless_windows) {
+		window->render();
+	}
+}
+
+void prop::platform::Window::exec() {
+	//there are no events that could close a window, so windows are drawn once
+	pump();
+}
+
+//UTF-8 continuation bytes do not start a new character
+static bool is_character_start(char c) {
+	return (static_cast<unsigned char>(c) & 0xc0) != 0x80;
+}
+
+static void draw_glyphs(prop::platform::Canvas_context &canvas_context, const prop::platform::canvas::Text_run &text,
+						prop::Size<int> glyph) {
+	const auto origin = static_cast<prop::Rect<int>>(text.rect);
+	int x = origin.left;
+	int y = origin.top;
+	for (auto c : text.text) {
+		if (not is_character_start(c)) {
+			continue;
+		}
+		if (c == '\n') {
+			x = origin.left;
+			y += glyph.height;
+			continue;
+		}
+		if (c != ' ') {
+			fill(canvas_context, {.top = y + 1, .left = x + 1, .bottom = y + glyph.height - 1, .right = x + glyph.width - 1},
+				 text.color);
+		}
+		x += glyph.width;
+	}
+}
+
+void prop::platform::canvas::draw_text(Canvas_context &canvas_context, const prop::Rect<> &rect, std::string_view text,
+									   const prop::Font &font) {
+	draw_glyphs(canvas_context, {.rect = rect, .text = text, .color = font.color},
+				prop::platform::headless::glyph_size(font));
+}
+
+void prop::platform::canvas::draw_texts(Canvas_context &canvas_context, std::span<const Text_run> texts,
+										const prop::Font &font) {
+	const auto glyph = prop::platform::headless::glyph_size(font);
+	for (const auto &text : texts) {
+		draw_glyphs(canvas_context, text, glyph);
+	}
+}
+
+void prop::platform::canvas::draw_rect(Canvas_context &canvas_context, prop::Rect<> rect, prop::Color color,
+									   float width_px) {
+	const auto width = static_cast<int>(std::ceil(std::abs(width_px)));
+	if (width == 0) {
+		return;
+	}
+	//like in the SFML backend the outline is drawn outside of the rect and inside of it for negative widths
+	const auto bounds = static_cast<prop::Rect<int>>(rect);
+	auto outer = bounds;
+	auto inner = bounds;
+	if (width_px > 0) {
+		outer = {.top = bounds.top - width, .left = bounds.left - width, .bottom = bounds.bottom + width,
+				 .right = bounds.right + width};
+	} else {
+		//an inner outline thicker than half of the rect fills it
+		inner.top = std::min(bounds.top + width, bounds.bottom);
+		inner.left = std::min(bounds.left + width, bounds.right);
+		inner.bottom = std::max(bounds.bottom - width, inner.top);
+		inner.right = std::max(bounds.right - width, inner.left);
+	}
+	fill(canvas_context, {.top = outer.top, .left = outer.left, .bottom = inner.top, .right = outer.right}, color);
+	fill(canvas_context, {.top = inner.bottom, .left = outer.left, .bottom = outer.bottom, .right = outer.right}, color);
+	fill(canvas_context, {.top = inner.top, .left = outer.left, .bottom = inner.bottom, .right = inner.left}, color);
+	fill(canvas_context, {.top = inner.top, .left = inner.right, .bottom = inner.bottom, .right = outer.right}, color);
+}
+
+void prop::platform::canvas::draw_rects(Canvas_context &canvas_context, std::span<const Rect_outline> rects) {
+	for (const auto &rect : rects) {
+		draw_rect(canvas_context, rect.rect, rect.color, rect.width_px);
+	}
+}
+
+int prop::platform::canvas::text_height(const prop::Font &font) {
+	return prop::platform::headless::glyph_size(font).height;
+}
+
+prop::Size<> prop::platform::canvas::text_size(std::string_view text, const Font &font) {
+	const auto glyph = prop::platform::headless::glyph_size(font);
+	int lines = text.empty() ? 0 : 1;
+	int longest_line = 0;
+	int line_length = 0;
+	for (auto c : text) {
+		if (not is_character_start(c)) {
+			continue;
+		}
+		if (c == '\n') {
+			lines++;
+			line_length = 0;
+			continue;
+		}
+		longest_line = std::max(longest_line, ++line_length);
+	}
+	return {.width = static_cast<float>(longest_line * glyph.width), .height = static_cast<float>(lines * glyph.height)};
+}
+
+std::vector<prop::platform::Screen> prop::platform::get_screens(prop::platform::Get_screens_strategy) {
+	return {{
+		.width_pixels = 1920,
+		.height_pixels = 1080,
+		.x_origin_pixels = 0,
+		.y_origin_pixels = 0,
+		.x_dpi = 96,
+		.y_dpi = 96,
+	}};
+}
+
+void prop::platform::refresh_screens() {}
+
+bool prop::platform::take_screens_changed() {
+	return false;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "platform.h"
+#include "prop/utility/color.h"
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace prop {
+	class Font;
+	class Window;
+
+	//Platform without a display. Windows are drawn into an in-memory RGBA framebuffer and text is drawn as one block
+	//per character with fixed metrics, so the output is identical on every machine.
+	namespace platform::headless {
+		struct Framebuffer {
+			int width = 0;
+			int height = 0;
+			//row major, in the format of prop::Color::to_rgba
+			std::vector<std::uint32_t> pixels;
+
+			prop::Color pixel(int x, int y) const;
+			void resize(int width, int height, prop::Color color);
+		};
+
+		//framebuffer a window has been drawn into by the last prop::Window::pump()
+		const Framebuffer &get_framebuffer(const prop::Window &window);
+		//writes a binary PPM image, the alpha channel is dropped
+		void write_ppm(const Framebuffer &framebuffer, std::ostream &os);
+		//size of a character cell of font
+		prop::Size<int> glyph_size(const prop::Font &font);
+	} // namespace platform::headless
+} // namespace prop
@@ -1,13 +1,24 @@
 #include "platform.h"
 #include "prop/ui/window.h"
 #include "prop/utility/canvas.h"
+#include "prop/utility/draw_list.h"
+#include "prop/utility/property_link.h"
 #include "prop/utility/utility.h"
 
 #include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Window/Event.hpp>
+#include <SFML/Window/VideoMode.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 struct SFML_window;
@@ -17,7 +28,7 @@ static std::vector<SFML_window *> sfml_windows;
 namespace prop::platform {
 	struct Canvas_context {
 		//SFML stuffs
-		sf::RenderWindow &window;
+		sf::RenderTarget &target;
 	};
 } // namespace prop::platform
 
@@ -39,27 +50,87 @@ struct SFML_window : prop::platform::Window {
 				sfml_window.close();
 				return false;
 			}
+			if (event.type == sf::Event::Resized) {
+				//SFML has no event for monitor changes, but they usually resize the windows on them
+				prop::platform::refresh_screens();
+				sfml_window.setView(sf::View{sf::FloatRect{0, 0, static_cast<float>(event.size.width),
+														   static_cast<float>(event.size.height)}});
+			}
 		}
-		sfml_window.clear(sf::Color::White);
+		prop::Graph_lock lock;
+		const auto window_size = sfml_window.getSize();
+		if (frame.getSize() != window_size) {
+			if (not frame.create(window_size.x, window_size.y)) {
+				throw prop::Io_error{"Failed creating a frame buffer"};
+			}
+			frame_outdated = true;
+		}
+		const prop::Rect<int> area{.bottom = window->size->height, .right = window->size->width};
+		if (frame_outdated) {
+			draw_list.clear();
+		}
+		std::vector<prop::Rect<int>> dirty_regions;
 		if (auto &wp = window->widget.get()) {
-			prop::platform::Canvas_context canvas_context{sfml_window};
-			prop::Canvas canvas{canvas_context, window->size->width, window->size->height};
-			window->draw(canvas);
+			dirty_regions = draw_list.update(*wp.get(), area);
+		} else {
+			draw_list.clear();
+		}
+		if (frame_outdated) {
+			dirty_regions = {area};
+			frame_outdated = false;
+		}
+		if (dirty_regions.empty()) {
+			//nothing changed, the window still shows the last frame
+			return true;
 		}
+		prop::platform::Canvas_context canvas_context{frame};
+		for (const auto &region : dirty_regions) {
+			//limiting the viewport to the region clips everything outside of it
+			const sf::FloatRect region_rect{static_cast<float>(region.left), static_cast<float>(region.top),
+											static_cast<float>(region.right - region.left),
+											static_cast<float>(region.bottom - region.top)};
+			sf::View view{region_rect};
+			view.setViewport({region_rect.left / static_cast<float>(window_size.x),
+							  region_rect.top / static_cast<float>(window_size.y),
+							  region_rect.width / static_cast<float>(window_size.x),
+							  region_rect.height / static_cast<float>(window_size.y)});
+			frame.setView(view);
+			sf::RectangleShape background{{region_rect.width, region_rect.height}};
+			background.setPosition(region_rect.left, region_rect.top);
+			background.setFillColor(sf::Color::White);
+			frame.draw(background);
+			draw_list.replay(canvas_context, region);
+		}
+		frame.setView(frame.getDefaultView());
+		frame.display();
+		sfml_window.clear(sf::Color::White);
+		sfml_window.draw(sf::Sprite{frame.getTexture()});
 		sfml_window.display();
 		return true;
 	}
+	//the window content is kept in frame so only changed regions need to be drawn again
+	prop::Draw_list draw_list;
+	sf::RenderTexture frame;
+	bool frame_outdated = true;
 	sf::RenderWindow sfml_window;
 };
 
 std::unique_ptr<prop::platform::Window, void (*)(prop::platform::Window *)>
 prop::platform::Window::create(prop::platform::Window::Params &&params) {
+	if (sfml_windows.empty()) {
+		//reading the screens starts a process, so it runs in the background while the window opens
+		prop::platform::refresh_screens();
+	}
 	return std::unique_ptr<prop::platform::Window, void (*)(prop::platform::Window *)>{
 		new SFML_window(params.width, params.height, params.title, params.window),
 		[](prop::platform::Window *window_) { delete static_cast<SFML_window *>(window_); }};
 }
 
 void prop::platform::Window::pump() {
+	if (prop::platform::take_screens_changed()) {
+		prop::Graph_lock lock;
+		prop::screens_version = prop::screens_version.get() + 1;
+	}
 	for (auto it = std::begin(sfml_windows); it != std::end(sfml_windows);) {
 		auto &sfml_window = (**it);
 		//TODO: Figure out a way to wait for events from multiple windows
@@ -77,76 +148,213 @@ void prop::platform::Window::exec() {
 	}
 }
 
-void prop::platform::canvas::draw_text(Canvas_context &canvas_context, const prop::Rect<> &rect, std::string_view text,
-									   const prop::Font &font) {
-	sf::Font sffont;
-	if (not sffont.loadFromFile(font.name)) {
-		throw prop::Io_error{"Failed opening file " + font.name};
+namespace {
+	//sf::Text objects hold a pointer to their sf::Font, so cached fonts must never move
+	std::unordered_map<std::string, sf::Font> fonts;
+
+	struct Text_style {
+		const sf::Font *font;
+		unsigned int character_size;
+		unsigned int style;
+		bool operator==(const Text_style &) const = default;
+	};
+	struct Text_style_hash {
+		std::size_t operator()(const Text_style &text_style) const {
+			return std::hash<const void *>{}(text_style.font) ^ (std::size_t{text_style.character_size} << 8) ^
+				   text_style.style;
+		}
+	};
+	//sf::Font caches glyphs per character size, so reusing configured sf::Text objects only touches memory
+	struct Text_metrics {
+		sf::Text text;
+		int line_height;
+	};
+	std::unordered_map<Text_style, Text_metrics, Text_style_hash> text_metrics;
+
+	//loading glyphs modifies the sf::Font, so measuring is serialized like drawing
+	std::mutex text_mutex;
+
+	const sf::Font &get_font(const std::string &name) {
+		if (auto it = fonts.find(name); it != std::end(fonts)) {
+			return it->second;
+		}
+		sf::Font sffont;
+		if (not sffont.loadFromFile(name)) {
+			throw prop::Io_error{"Failed opening file \"" + name + "\""};
+		}
+		return fonts.emplace(name, std::move(sffont)).first->second;
 	}
-	sf::Text sftext;
-	sftext.setPosition(static_cast<float>(rect.left), static_cast<float>(rect.top));
-	sftext.setFont(sffont);
-	sftext.setString(std::string{text}); //TODO: Figure out a way to avoid the temporary std::string
-	sftext.setCharacterSize(static_cast<unsigned int>(font.size.amount));
-	sftext.setFillColor(sf::Color{font.color.r, font.color.g, font.color.b, font.color.a});
-	unsigned int style = sf::Text::Regular;
-	if (font.italic) {
-		style |= sf::Text::Italic;
+
+	Text_metrics &get_text_metrics(const prop::Font &font) {
+		unsigned int style = sf::Text::Regular;
+		if (font.italic) {
+			style |= sf::Text::Italic;
+		}
+		if (font.strikeout) {
+			style |= sf::Text::StrikeThrough;
+		}
+		if (font.underline) {
+			style |= sf::Text::Underlined;
+		}
+		if (font.bold) {
+			style |= sf::Text::Bold;
+		}
+		const Text_style text_style{
+			.font = &get_font(font.name),
+			.character_size = static_cast<unsigned int>(font.size.amount),
+			.style = style,
+		};
+		if (auto it = text_metrics.find(text_style); it != std::end(text_metrics)) {
+			return it->second;
+		}
+		sf::Text sftext;
+		sftext.setFont(*text_style.font);
+		sftext.setCharacterSize(text_style.character_size);
+		sftext.setStyle(text_style.style);
+		const auto line_height = static_cast<int>(std::ceil(text_style.font->getLineSpacing(text_style.character_size)));
+		return text_metrics.emplace(text_style, Text_metrics{.text = std::move(sftext), .line_height = line_height})
+			.first->second;
+	}
+} // namespace
+
+namespace {
+	void add_quad(sf::VertexArray &vertices, sf::FloatRect rect, sf::Color color, sf::FloatRect texture_rect = {}) {
+		const sf::Vector2f top_left{rect.left, rect.top};
+		const sf::Vector2f top_right{rect.left + rect.width, rect.top};
+		const sf::Vector2f bottom_left{rect.left, rect.top + rect.height};
+		const sf::Vector2f bottom_right{rect.left + rect.width, rect.top + rect.height};
+		const sf::Vector2f texture_top_left{texture_rect.left, texture_rect.top};
+		const sf::Vector2f texture_top_right{texture_rect.left + texture_rect.width, texture_rect.top};
+		const sf::Vector2f texture_bottom_left{texture_rect.left, texture_rect.top + texture_rect.height};
+		const sf::Vector2f texture_bottom_right{texture_rect.left + texture_rect.width,
+												texture_rect.top + texture_rect.height};
+		vertices.append({top_left, color, texture_top_left});
+		vertices.append({top_right, color, texture_top_right});
+		vertices.append({bottom_left, color, texture_bottom_left});
+		vertices.append({bottom_left, color, texture_bottom_left});
+		vertices.append({top_right, color, texture_top_right});
+		vertices.append({bottom_right, color, texture_bottom_right});
 	}
-	if (font.strikeout) {
-		style |= sf::Text::StrikeThrough;
+
+	//sf::Text draws the line decorations and slanted glyphs that the vertex arrays of draw_texts leave out
+	void draw_styled_text(prop::platform::Canvas_context &canvas_context, sf::Text &sftext,
+						  const prop::platform::canvas::Text_run &text) {
+		sftext.setPosition(text.rect.left, text.rect.top);
+		sftext.setString(sf::String::fromUtf8(std::begin(text.text), std::end(text.text)));
+		sftext.setFillColor(sf::Color{text.color.to_rgba()});
+		canvas_context.target.draw(sftext);
 	}
-	if (font.underline) {
-		style |= sf::Text::Underlined;
+} // namespace
+
+void prop::platform::canvas::draw_text(Canvas_context &canvas_context, const prop::Rect<> &rect, std::string_view text,
+									   const prop::Font &font) {
+	const Text_run run{.rect = rect, .text = text, .color = font.color};
+	draw_texts(canvas_context, {&run, 1}, font);
+}
+
+void prop::platform::canvas::draw_texts(Canvas_context &canvas_context, std::span<const Text_run> texts,
+										const prop::Font &font) {
+	std::lock_guard lock{text_mutex};
+	auto &metrics = get_text_metrics(font);
+	if (font.italic or font.underline or font.strikeout) {
+		for (const auto &text : texts) {
+			draw_styled_text(canvas_context, metrics.text, text);
+		}
+		return;
 	}
-	if (font.bold) {
-		style |= sf::Text::Bold;
+	//all glyphs of a face are on the same texture, so the texts are drawn with a single draw call
+	const auto &sffont = *metrics.text.getFont();
+	const auto character_size = metrics.text.getCharacterSize();
+	//whitespace is laid out the way sf::Text does it, so the texts look the same as with draw_styled_text
+	const auto whitespace_width = sffont.getGlyph(' ', character_size, font.bold).advance;
+	const auto line_spacing = sffont.getLineSpacing(character_size);
+	sf::VertexArray vertices{sf::Triangles};
+	for (const auto &text : texts) {
+		const sf::Color color{text.color.to_rgba()};
+		//like sf::Text, the baseline of the first line is one character size below the top
+		float x = text.rect.left;
+		float y = text.rect.top + static_cast<float>(character_size);
+		std::uint32_t previous = 0;
+		for (const auto codepoint : sf::String::fromUtf8(std::begin(text.text), std::end(text.text))) {
+			if (codepoint == '\r') {
+				continue;
+			}
+			x += sffont.getKerning(previous, codepoint, character_size);
+			previous = codepoint;
+			switch (codepoint) {
+				case ' ':
+					x += whitespace_width;
+					continue;
+				case '\t':
+					x += whitespace_width * 4;
+					continue;
+				case '\n':
+					x = text.rect.left;
+					y += line_spacing;
+					continue;
+			}
+			const auto &glyph = sffont.getGlyph(codepoint, character_size, font.bold);
+			add_quad(vertices, {x + glyph.bounds.left, y + glyph.bounds.top, glyph.bounds.width, glyph.bounds.height},
+					 color, sf::FloatRect{glyph.textureRect});
+			x += glyph.advance;
+		}
 	}
-	sftext.setStyle(style);
-	canvas_context.window.draw(sftext);
+	//the texture may have grown while the glyphs were loaded, so it is only looked up once they all are
+	canvas_context.target.draw(vertices, sf::RenderStates{&sffont.getTexture(character_size)});
 }
 
 void prop::platform::canvas::draw_rect(Canvas_context &canvas_context, prop::Rect<> rect, prop::Color color,
 									   float width_px) {
-	sf::RectangleShape sfrect{sf::Vector2f(rect.width(), rect.height())};
-	sfrect.setPosition(rect.left, rect.top);
-	sfrect.setOutlineColor(sf::Color{color.to_rgba()});
-	sfrect.setOutlineThickness(width_px);
-	sfrect.setFillColor(sf::Color::Transparent);
-	canvas_context.window.draw(sfrect);
+	const Rect_outline outline{.rect = rect, .color = color, .width_px = width_px};
+	draw_rects(canvas_context, {&outline, 1});
 }
 
-prop::Size<> prop::platform::canvas::text_size(std::string_view text, const Font &font) {
-	sf::Font sffont;
-	if (not sffont.loadFromFile(font.name)) {
-		throw prop::Io_error{"Failed opening file \"" + font.name + "\""};
+void prop::platform::canvas::draw_rects(Canvas_context &canvas_context, std::span<const Rect_outline> rects) {
+	sf::VertexArray vertices{sf::Triangles};
+	for (const auto &[rect, color, width_px] : rects) {
+		//like sf::Shape, the outline is drawn outside of the rect and inside of it for negative widths
+		const auto outset = std::max(width_px, 0.f);
+		const sf::Color sfcolor{color.to_rgba()};
+		const sf::FloatRect outer{rect.left - outset, rect.top - outset, rect.right - rect.left + 2 * outset,
+								  rect.bottom - rect.top + 2 * outset};
+		//an inner outline thicker than half of the rect fills it
+		const auto width = std::min({std::abs(width_px), outer.width / 2, outer.height / 2});
+		const auto side_height = outer.height - 2 * width;
+		add_quad(vertices, {outer.left, outer.top, outer.width, width}, sfcolor);
+		add_quad(vertices, {outer.left, outer.top + outer.height - width, outer.width, width}, sfcolor);
+		add_quad(vertices, {outer.left, outer.top + width, width, side_height}, sfcolor);
+		add_quad(vertices, {outer.left + outer.width - width, outer.top + width, width, side_height}, sfcolor);
 	}
-	sf::Text sftext;
-	sftext.setFont(sffont);
+	canvas_context.target.draw(vertices);
+}
+
+int prop::platform::canvas::text_height(const prop::Font &font) {
+	std::lock_guard lock{text_mutex};
+	return get_text_metrics(font).line_height;
+}
+
+prop::Size<> prop::platform::canvas::text_size(std::string_view text, const Font &font) {
+	std::lock_guard lock{text_mutex};
+	auto &sftext = get_text_metrics(font).text;
 	sftext.setString(std::string{text}); //TODO: Figure out a way to avoid the temporary std::string
-	sftext.setCharacterSize(static_cast<unsigned int>(font.size.amount));
-	unsigned int style = sf::Text::Regular;
-	if (font.italic) {
-		style |= sf::Text::Italic;
-	}
-	if (font.strikeout) {
-		style |= sf::Text::StrikeThrough;
-	}
-	if (font.underline) {
-		style |= sf::Text::Underlined;
-	}
-	if (font.bold) {
-		style |= sf::Text::Bold;
-	}
-	sftext.setStyle(style);
 	const auto &sfrect = sftext.getLocalBounds();
 	return {.width = sfrect.width, .height = sfrect.height};
 }
 
 #if __unix__
 #include "platform_xrandr_screen.h"
+
 std::vector<prop::platform::Screen> prop::platform::get_screens(prop::platform::Get_screens_strategy strategy) {
-	auto raw_screens = get_xandr_screens();
+	//until the first read finished the desktop is assumed to be a single 96 DPI screen, the finished read then updates
+	//prop::screens through take_screens_changed
+	auto raw_screens = get_xandr_screens().value_or(std::vector<prop::platform::Screen>{{
+		.width_pixels = static_cast<long double>(sf::VideoMode::getDesktopMode().width),
+		.height_pixels = static_cast<long double>(sf::VideoMode::getDesktopMode().height),
+		.x_origin_pixels = 0,
+		.y_origin_pixels = 0,
+		.x_dpi = 96,
+		.y_dpi = 96,
+	}});
 	switch (strategy) {
 		case prop::platform::Get_screens_strategy::compatibility:
 			//TODO
@@ -161,6 +369,14 @@ std::vector<prop::platform::Screen> prop::platform::get_screens(prop::platform::
 	}
 	return raw_screens;
 }
+
+void prop::platform::refresh_screens() {
+	refresh_xrandr_screens();
+}
+
+bool prop::platform::take_screens_changed() {
+	return take_xrandr_screens_changed();
+}
 #else
 #error
 #endif
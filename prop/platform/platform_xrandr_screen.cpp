@@ -1,9 +1,15 @@
 #include "platform_xrandr_screen.h"
 
+#include <algorithm>
+#include <charconv>
+#include <chrono>
 #include <cstdio>
+#include <future>
 #include <memory>
 #include <mutex>
-#include <regex>
+#include <optional>
+#include <string>
+#include <utility>
 
 //TODO: Extract to utility file
 static std::string get_output_from_command(std::string_view command) {
@@ -30,19 +36,108 @@ static std::string get_output_from_command(std::string_view command) {
 	return buffer;
 }
 
-std::vector<prop::platform::Screen> get_xandr_screens() {
+namespace {
+	//function-local so the state exists before the first refresh, no matter when that happens
+	struct Screen_state {
+		std::mutex mutex;
+		std::optional<std::vector<prop::platform::Screen>> cached;
+		bool changed = false;
+		std::future<void> refresh; //last member so the refresh is finished before the rest is destroyed
+	};
+	Screen_state &screen_state() {
+		static Screen_state state;
+		return state;
+	}
+
+	void read_screens() {
+		auto &state = screen_state();
+		std::optional<std::vector<prop::platform::Screen>> screens;
+		try {
+			screens = parse_xrandr_screens(get_output_from_command("xrandr --listactivemonitors"));
+		} catch (...) {
+		}
+		if (not screens) {
+			//the previous screens, or the provisional ones before the first read, stay in use
+			return;
+		}
+		std::lock_guard lock{state.mutex};
+		//the first read replaces the provisional screens, so it is always a change
+		state.changed = state.changed or not state.cached or *state.cached != *screens;
+		state.cached = std::move(screens);
+	}
+
+	//reads the number at the start of text and removes it, fails if it is not followed by separator
+	bool consume_number(std::string_view &text, long &number, std::string_view separator) {
+		const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), number);
+		if (error != std::errc{}) {
+			return false;
+		}
+		text.remove_prefix(static_cast<std::size_t>(end - text.data()));
+		if (not text.starts_with(separator)) {
+			return false;
+		}
+		text.remove_prefix(separator.size());
+		return true;
+	}
+
+	//a monitor is described as <width>/<width mm>x<height>/<height mm>+<x>+<y>
+	std::optional<prop::platform::Screen> parse_monitor(std::string_view word) {
+		long width = 0, width_mm = 0, height = 0, height_mm = 0, x = 0, y = 0;
+		if (not(consume_number(word, width, "/") and consume_number(word, width_mm, "x") and
+				consume_number(word, height, "/") and consume_number(word, height_mm, "+") and
+				consume_number(word, x, "+") and consume_number(word, y, "") and word.empty())) {
+			return std::nullopt;
+		}
+		const auto dpi = [](long pixels, long millimeters) {
+			return millimeters > 0 ? static_cast<long double>(pixels) / static_cast<long double>(millimeters) * 25.4l
+								   : 96.l;
+		};
+		return prop::platform::Screen{
+			.width_pixels = static_cast<long double>(width),
+			.height_pixels = static_cast<long double>(height),
+			.x_origin_pixels = static_cast<long double>(x),
+			.y_origin_pixels = static_cast<long double>(y),
+			.x_dpi = dpi(width, width_mm),
+			.y_dpi = dpi(height, height_mm),
+		};
+	}
+} // namespace
+
+void refresh_xrandr_screens() {
+	auto &state = screen_state();
+	std::lock_guard lock{state.mutex};
+	if (state.refresh.valid() and state.refresh.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+		return;
+	}
+	state.refresh = std::async(std::launch::async, read_screens);
+}
+
+std::optional<std::vector<prop::platform::Screen>> get_xandr_screens() {
+	auto &state = screen_state();
+	std::lock_guard lock{state.mutex};
+	return state.cached;
+}
+
+bool take_xrandr_screens_changed() {
+	auto &state = screen_state();
+	std::lock_guard lock{state.mutex};
+	return std::exchange(state.changed, false);
+}
+
+std::vector<prop::platform::Screen> parse_xrandr_screens(std::string_view output) {
 	std::vector<prop::platform::Screen> screens;
-	auto output = get_output_from_command("xrandr --listactivemonitors");
-	const std::regex r(R"(\s(\d+)\/(\d+)x(\d+)\/(\d+)\+(\d+)\+(\d+)\s)");
-	for (std::smatch sm; regex_search(output, sm, r); output = sm.suffix()) {
-		prop::platform::Screen screen;
-		screen.width_pixels = std::atoi(sm[1].str().c_str());
-		screen.height_pixels = std::atoi(sm[3].str().c_str());
-		screen.x_origin_pixels = std::atoi(sm[5].str().c_str());
-		screen.y_origin_pixels = std::atoi(sm[6].str().c_str());
-		screen.x_dpi = screen.width_pixels / std::atoi(sm[2].str().c_str()) * 25.4l;
-		screen.y_dpi = screen.height_pixels / std::atoi(sm[4].str().c_str()) * 25.4l;
-		screens.push_back(std::move(screen));
+	constexpr std::string_view whitespace = " \t\r\n";
+	while (not output.empty()) {
+		const auto word_start = output.find_first_not_of(whitespace);
+		if (word_start == std::string_view::npos) {
+			break;
+		}
+		output.remove_prefix(word_start);
+		const auto word_end = std::min(output.find_first_of(whitespace), output.size());
+		if (auto screen = parse_monitor(output.substr(0, word_end))) {
+			screens.push_back(*screen);
+		}
+		output.remove_prefix(word_end);
 	}
 	return screens;
 }
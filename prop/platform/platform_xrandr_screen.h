@@ -2,4 +2,15 @@
 
 #include "platform.h"
 
-std::vector<prop::platform::Screen> get_xandr_screens();
+#include <optional>
+#include <string_view>
+
+//Screens are read with `xrandr --listactivemonitors` on a background thread and cached.
+//starts reading the screens unless that is already in progress
+void refresh_xrandr_screens();
+//screens of the last successful refresh, std::nullopt until the first one finished, never waits
+std::optional<std::vector<prop::platform::Screen>> get_xandr_screens();
+//whether a refresh found different screens since the last call
+bool take_xrandr_screens_changed();
+//parses the output of `xrandr --listactivemonitors`
+std::vector<prop::platform::Screen> parse_xrandr_screens(std::string_view output);
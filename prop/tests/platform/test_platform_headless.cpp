@@ -0,0 +1,58 @@
+#include "prop/platform/platform_headless.h"
+#include "prop/ui/label.h"
+#include "prop/ui/widget.h"
+#include "prop/ui/window.h"
+#include "prop/utility/canvas.h"
+
+#include <catch2/catch_all.hpp>
+#include <sstream>
+
+TEST_CASE("Headless windows draw into a framebuffer", "[Headless]") {
+	prop::Label label{{.text = "ab"}};
+	prop::Window window{{
+		.size = prop::Size<int>{64, 32},
+		.widget = &label,
+	}};
+	prop::Window::pump();
+	const auto &framebuffer = prop::platform::headless::get_framebuffer(window);
+	REQUIRE(framebuffer.width == 64);
+	REQUIRE(framebuffer.height == 32);
+	const auto glyph = prop::platform::headless::glyph_size(label.font);
+	REQUIRE(label.get_preferred_size()->width == 2 * glyph.width);
+	REQUIRE(framebuffer.pixel(1, 1).to_rgba() == label.font->color.to_rgba());
+	REQUIRE(framebuffer.pixel(2 * glyph.width + 1, 1).to_rgba() == prop::Color::white.to_rgba());
+
+	label.text = "b";
+	prop::Window::pump();
+	REQUIRE(framebuffer.pixel(glyph.width + 1, 1).to_rgba() == prop::Color::white.to_rgba());
+
+	std::stringstream ppm;
+	prop::platform::headless::write_ppm(framebuffer, ppm);
+	REQUIRE(ppm.str().starts_with("P6\n64 32\n255\n"));
+	REQUIRE(std::size(ppm.str()) == std::size("P6\n64 32\n255\n") - 1 + 64 * 32 * 3);
+}
+
+TEST_CASE("Negative outline widths are drawn inside of the rect", "[Headless]") {
+	struct Outlines : prop::Widget {
+		void draw(prop::Canvas canvas) const override {
+			canvas.draw_rect({.top = 10, .left = 10, .bottom = 20, .right = 20}, prop::Color::red, prop::Pixels{-2});
+			canvas.draw_rect({.top = 10, .left = 30, .bottom = 20, .right = 40}, prop::Color::red, prop::Pixels{2});
+		}
+	} outlines;
+	prop::Window window{{
+		.size = prop::Size<int>{64, 32},
+		.widget = &outlines,
+	}};
+	prop::Window::pump();
+	const auto &framebuffer = prop::platform::headless::get_framebuffer(window);
+	const auto red = prop::Color::red.to_rgba();
+	const auto white = prop::Color::white.to_rgba();
+	REQUIRE(framebuffer.pixel(10, 15).to_rgba() == red);
+	REQUIRE(framebuffer.pixel(11, 15).to_rgba() == red);
+	REQUIRE(framebuffer.pixel(12, 15).to_rgba() == white);
+	REQUIRE(framebuffer.pixel(9, 15).to_rgba() == white);
+	REQUIRE(framebuffer.pixel(28, 15).to_rgba() == red);
+	REQUIRE(framebuffer.pixel(29, 15).to_rgba() == red);
+	REQUIRE(framebuffer.pixel(30, 15).to_rgba() == white);
+	REQUIRE(framebuffer.pixel(27, 15).to_rgba() == white);
+}
@@ -0,0 +1,19 @@
+#include "prop/platform/platform_xrandr_screen.h"
+
+#include <catch2/catch_all.hpp>
+
+TEST_CASE("Parse xrandr monitors", "[xrandr]") {
+	const auto screens = parse_xrandr_screens("Monitors: 2\n"
+											  " 0: +*DP-1 2540/508x1270/254+0+0  DP-1\n"
+											  " 1: +HDMI-1 1920/0x1080/0+2540+-10  HDMI-1\n");
+	REQUIRE(screens.size() == 2);
+	REQUIRE(screens[0].width_pixels == 2540);
+	REQUIRE(screens[0].height_pixels == 1270);
+	REQUIRE(static_cast<double>(screens[0].x_dpi) == Catch::Approx(127));
+	REQUIRE(static_cast<double>(screens[0].y_dpi) == Catch::Approx(127));
+	REQUIRE(screens[1].x_origin_pixels == 2540);
+	REQUIRE(screens[1].y_origin_pixels == -10);
+	REQUIRE(screens[1].x_dpi == 96);
+	REQUIRE(parse_xrandr_screens("").empty());
+	REQUIRE(parse_xrandr_screens("Monitors: 0\n").empty());
+}
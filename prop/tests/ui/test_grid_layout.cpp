@@ -0,0 +1,63 @@
+#include "prop/ui/grid_layout.h"
+#include "prop/ui/horizontal_layout.h"
+
+#include <catch2/catch_all.hpp>
+
+namespace {
+	struct Sized_widget : prop::Widget {
+		Sized_widget(prop::Size<> min, prop::Size<> preferred) {
+			set_size(min, preferred);
+		}
+		void set_size(prop::Size<> min, prop::Size<> preferred) {
+			min_size = min;
+			preferred_size = preferred;
+		}
+	};
+} // namespace
+
+TEST_CASE("Horizontal layout shares its width", "[Horizontal_layout]") {
+	Sized_widget w1{{10, 10}, {20, 10}}, w2{{10, 20}, {40, 20}};
+	prop::Horizontal_layout hl{&w1, &w2};
+	REQUIRE(hl.get_min_size() == prop::Size<>{20, 20});
+	REQUIRE(hl.get_preferred_size() == prop::Size<>{60, 20});
+
+	hl.position = prop::Rect<>{.bottom = 30, .right = 40};
+	REQUIRE(w1.position == prop::Rect<>{.top = 0, .left = 0, .bottom = 30, .right = 15});
+	REQUIRE(w2.position == prop::Rect<>{.top = 0, .left = 15, .bottom = 30, .right = 40});
+
+	hl.position = prop::Rect<>{.bottom = 30, .right = 100};
+	REQUIRE(w1.position->right == 40);
+	REQUIRE(w2.position->right == 100);
+
+	Sized_widget w3{{10, 10}, {10, 10}};
+	hl.children.apply()->push_back(&w3);
+	REQUIRE(hl.get_min_size() == prop::Size<>{30, 20});
+}
+
+TEST_CASE("Grid columns and rows fit their largest cell", "[Grid_layout]") {
+	Sized_widget w1{{10, 10}, {10, 10}}, w2{{30, 10}, {30, 10}}, w3{{20, 20}, {20, 20}};
+	prop::Grid_layout grid{{.columns = 2, .children = std::vector<prop::Polywrap<prop::Widget>>{&w1, &w2, &w3}}};
+	REQUIRE(grid.get_min_size() == prop::Size<>{50, 30});
+	grid.position = prop::Rect<>{.bottom = 30, .right = 50};
+	REQUIRE(w1.position == prop::Rect<>{.top = 0, .left = 0, .bottom = 10, .right = 20});
+	REQUIRE(w2.position == prop::Rect<>{.top = 0, .left = 20, .bottom = 10, .right = 50});
+	REQUIRE(w3.position == prop::Rect<>{.top = 10, .left = 0, .bottom = 30, .right = 20});
+
+	w3.set_size({40, 20}, {40, 20});
+	REQUIRE(grid.get_min_size() == prop::Size<>{70, 30});
+	REQUIRE(w2.position->left == 40);
+
+	grid.columns = 3;
+	REQUIRE(grid.get_min_size() == prop::Size<>{80, 20});
+}
+
+TEST_CASE("Nested layouts follow their children", "[Grid_layout]") {
+	Sized_widget w1{{10, 10}, {10, 10}}, w2{{10, 10}, {10, 10}};
+	prop::Grid_layout grid{{.columns = 1}};
+	grid.children.apply()->push_back(prop::Horizontal_layout{&w1, &w2});
+	grid.position = prop::Rect<>{.bottom = 10, .right = 20};
+	REQUIRE(w2.position->left == 10);
+	w1.set_size({30, 10}, {30, 10});
+	REQUIRE(grid.get_min_size() == prop::Size<>{40, 10});
+	REQUIRE(w2.position->left == 30);
+}
@@ -0,0 +1,54 @@
+#include "prop/ui/list_view.h"
+
+#include <catch2/catch_all.hpp>
+
+namespace {
+	struct Row_widget : prop::Widget {
+		Row_widget(const prop::Property<std::size_t> &index)
+			: item{[&index] { return index.get(); }} {}
+		prop::Property<std::size_t> item;
+	};
+} // namespace
+
+TEST_CASE("Only visible rows are created", "[List_view]") {
+	int created_rows = 0;
+	prop::List_view list_view{{
+		.item_count = 1'000'000,
+		.row_height = 10,
+		.overscan = 2,
+		.row_factory = [&](const prop::Property<std::size_t> &index) -> prop::Polywrap<prop::Widget> {
+			created_rows++;
+			return Row_widget{index};
+		},
+	}};
+	list_view.position = prop::Rect<>{.bottom = 100, .right = 50};
+	REQUIRE(list_view.get_row_count().get() == 12);
+	REQUIRE(created_rows == 12);
+	REQUIRE(list_view.get_row(0)->position->top == 0);
+	REQUIRE(list_view.get_row(11)->position->top == 110);
+	REQUIRE(list_view.get_row(11)->position->right == 50);
+	REQUIRE(list_view.get_row(12) == nullptr);
+
+	list_view.scroll_to(500'000);
+	REQUIRE(list_view.get_row_count().get() == 14);
+	REQUIRE(created_rows == 14);
+	REQUIRE(list_view.get_row(500'000)->position->top == 0);
+	REQUIRE(list_view.get_row(499'998)->position->top == -20);
+	REQUIRE(list_view.get_row(0) == nullptr);
+	auto row = static_cast<const Row_widget *>(list_view.get_row(500'005));
+	REQUIRE(row->item.get() == 500'005);
+
+	list_view.scroll_offset = list_view.scroll_offset.get() + 10;
+	REQUIRE(created_rows == 14);
+	REQUIRE(list_view.get_row(499'998) == nullptr);
+	row = static_cast<const Row_widget *>(list_view.get_row(500'012));
+	REQUIRE(row->item.get() == 500'012);
+	REQUIRE(row->position->top == 110);
+
+	//scrolled past the end, only the overscan rows above the end remain
+	list_view.item_count = 5;
+	REQUIRE(list_view.get_row_count().get() == 2);
+	list_view.scroll_to(0);
+	REQUIRE(list_view.get_row_count().get() == 5);
+	REQUIRE(static_cast<const Row_widget *>(list_view.get_row(4))->item.get() == 4);
+}
@@ -37,3 +37,63 @@ TEST_CASE("Apply width to assigned children", "[Vertical_layout]") {
 	REQUIRE(vl.children[0]->position->right == vl.position->right);
 	REQUIRE(vl.children[1]->position->right == vl.position->right);
 }
+
+namespace {
+	struct Sized_widget : prop::Widget {
+		Sized_widget(PROP_SCREEN_UNIT_PRECISION height) {
+			set_height(height);
+		}
+		void set_height(PROP_SCREEN_UNIT_PRECISION height) {
+			min_size = prop::Size<>{10, height};
+		}
+	};
+} // namespace
+
+TEST_CASE("Only children below a resized child move", "[Vertical_layout]") {
+	Sized_widget w1{10}, w2{20}, w3{30};
+	prop::Vertical_layout vl{&w1, &w2, &w3};
+	vl.position.apply()->right = 100;
+	REQUIRE(w3.position->top == 30);
+	REQUIRE(vl.get_min_size()->height == 60);
+	int w1_moves = 0;
+	prop::Property<void> w1_observer = [&] {
+		w1.position.get();
+		w1_moves++;
+	};
+	REQUIRE(w1_moves == 1);
+	w2.set_height(25);
+	REQUIRE(w2.position->bottom == 35);
+	REQUIRE(w3.position->top == 35);
+	REQUIRE(w3.position->bottom == 65);
+	REQUIRE(vl.get_min_size()->height == 65);
+	REQUIRE(w1_moves == 1);
+	vl.position.apply()->right = 200;
+	REQUIRE(w1.position->right == 200);
+	REQUIRE(w3.position->right == 200);
+	REQUIRE(w1_moves == 2);
+}
+
+TEST_CASE("Appending a child leaves the other children alone", "[Vertical_layout]") {
+	Sized_widget w1{10}, w2{20}, w3{30};
+	prop::Vertical_layout vl{&w1, &w2};
+	vl.set_name("vl");
+	vl.position.apply()->right = 100;
+	int w2_moves = 0;
+	prop::Property<void> w2_observer = [&] {
+		w2.position.get();
+		w2_moves++;
+	};
+	w2.custom_name = "renamed";
+	vl.children.emplace_back(&w3);
+	REQUIRE(w3.position->top == 30);
+	REQUIRE(vl.get_min_size()->height == 60);
+	REQUIRE(w2_moves == 1);
+	REQUIRE(w2.custom_name == "renamed");
+	REQUIRE(w3.position.custom_name == "vl.children[2].position");
+
+	vl.children.erase(0);
+	REQUIRE(w2.position->top == 0);
+	REQUIRE(w3.position->top == 20);
+	REQUIRE(w2_moves == 2);
+	REQUIRE(w2.position.custom_name == "vl.children[0].position");
+}
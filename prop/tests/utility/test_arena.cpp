@@ -0,0 +1,85 @@
+#include "prop/utility/arena.h"
+#include "prop/utility/polywrap.h"
+#include "prop/utility/property.h"
+
+#include <array>
+#include <catch2/catch_all.hpp>
+
+namespace {
+	struct Counting_resource : std::pmr::memory_resource {
+		int allocations = 0;
+
+		private:
+		void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+			allocations++;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+		void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+		bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+			return this == &other;
+		}
+	};
+} // namespace
+
+TEST_CASE("Arena scope redirects property allocations", "[Arena]") {
+	Counting_resource upstream;
+	auto previous_default = std::pmr::set_default_resource(&upstream);
+	{
+		prop::Arena arena{4096};
+		const auto allocations_before = upstream.allocations;
+		prop::Arena::Scope scope{arena};
+		REQUIRE(prop::current_memory_resource() == arena.resource());
+		prop::Property source = 1;
+		std::array<prop::Property<int>, 10> dependents;
+		for (auto &dependent : dependents) {
+			dependent = [&source] { return source + 1; };
+		}
+		std::array<int, 100> big_capture{};
+		prop::Property<int> big_binding = [&source, big_capture] { return source + big_capture[0]; };
+		source = 2;
+		REQUIRE(dependents[9] == 3);
+		REQUIRE(big_binding == 2);
+		REQUIRE(upstream.allocations <= allocations_before + 1); //the first block of the arena
+	}
+	std::pmr::set_default_resource(previous_default);
+	REQUIRE(prop::current_memory_resource() == std::pmr::new_delete_resource());
+}
+
+TEST_CASE("Arena objects can be owned by a Polywrap", "[Arena]") {
+	prop::Arena arena;
+	prop::Polywrap<prop::Property<int>> wrapped = arena.make<prop::Property<int>>(42);
+	REQUIRE(*wrapped == 42);
+	prop::Property<int> dependent = [&wrapped] { return *wrapped + 1; };
+	REQUIRE(dependent == 43);
+	wrapped = nullptr;
+	REQUIRE(dependent == 43);
+}
+
+TEST_CASE("Properties created outside of an arena can outlive it", "[Arena]") {
+	prop::Property hub = 1;
+	prop::Property<int> external;
+	{
+		prop::Arena arena;
+		prop::Arena::Scope scope{arena};
+		std::array<prop::Property<int>, 50> dependents;
+		for (auto &dependent : dependents) {
+			dependent = [&hub] { return hub + 1; };
+		}
+		std::array<int, 100> big_capture{};
+		big_capture[0] = 10;
+		external = [&hub, big_capture] { return hub + big_capture[0]; };
+		REQUIRE(dependents[49] == 2);
+		REQUIRE(external == 11);
+	}
+	hub = 2;
+	REQUIRE(external == 12);
+	std::array<prop::Property<int>, 50> later;
+	for (auto &dependent : later) {
+		dependent = [&hub] { return hub * 2; };
+	}
+	hub = 3;
+	REQUIRE(later[49] == 6);
+	REQUIRE(external == 13);
+}
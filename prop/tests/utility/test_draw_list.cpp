@@ -0,0 +1,80 @@
+#include "prop/ui/widget.h"
+#include "prop/utility/canvas.h"
+#include "prop/utility/draw_list.h"
+
+#include <catch2/catch_all.hpp>
+
+namespace {
+	struct Box : prop::Widget {
+		Box(prop::Rect<> position_) {
+			position = position_;
+		}
+		void draw(prop::Canvas canvas) const override {
+			draws++;
+			canvas.draw_rect(position, color.get());
+		}
+		prop::Property<prop::Color> color = prop::Color::red;
+		mutable int draws = 0;
+	};
+
+	struct Pair : prop::Widget {
+		Pair() {
+			position = prop::Rect<>{.bottom = 100, .right = 100};
+		}
+		void draw(prop::Canvas canvas) const override {
+			draws++;
+			canvas.draw_widget(first);
+			canvas.draw_widget(second);
+		}
+		Box first{{.top = 0, .left = 0, .bottom = 10, .right = 10}};
+		Box second{{.top = 50, .left = 50, .bottom = 60, .right = 60}};
+		mutable int draws = 0;
+	};
+} // namespace
+
+TEST_CASE("Only changed widgets are recorded again", "[Draw_list]") {
+	Pair pair;
+	prop::Draw_list draw_list;
+	const prop::Rect<int> area{.bottom = 100, .right = 100};
+	REQUIRE(not draw_list.update(pair, area).empty());
+	REQUIRE(pair.draws == 1);
+	REQUIRE(pair.first.draws == 1);
+	REQUIRE(pair.second.draws == 1);
+
+	REQUIRE(draw_list.update(pair, area).empty());
+	REQUIRE(pair.draws == 1);
+	REQUIRE(pair.first.draws == 1);
+
+	pair.first.color = prop::Color::blue;
+	auto dirty_regions = draw_list.update(pair, area);
+	REQUIRE(not dirty_regions.empty());
+	for (const auto &region : dirty_regions) {
+		REQUIRE(not prop::intersects(region, prop::Rect<int>{.top = 45, .left = 45, .bottom = 65, .right = 65}));
+	}
+	REQUIRE(pair.draws == 1);
+	REQUIRE(pair.first.draws == 2);
+	REQUIRE(pair.second.draws == 1);
+
+	pair.second.position = prop::Rect<>{.top = 70, .left = 70, .bottom = 80, .right = 80};
+	dirty_regions = draw_list.update(pair, area);
+	REQUIRE(not dirty_regions.empty());
+	REQUIRE(pair.draws == 2);
+	REQUIRE(draw_list.update(pair, area).empty());
+}
+
+TEST_CASE("Invisible and clipped widgets are not drawn", "[Draw_list]") {
+	Pair pair;
+	prop::Draw_list draw_list;
+	const prop::Rect<int> area{.bottom = 100, .right = 100};
+	pair.first.visible = false;
+	pair.second.position = prop::Rect<>{.top = 150, .left = 150, .bottom = 160, .right = 160};
+	draw_list.update(pair, area);
+	REQUIRE(pair.draws == 1);
+	REQUIRE(pair.first.draws == 0);
+	REQUIRE(pair.second.draws == 0);
+
+	pair.first.visible = true;
+	REQUIRE(not draw_list.update(pair, area).empty());
+	REQUIRE(pair.first.draws == 1);
+	REQUIRE(pair.second.draws == 0);
+}
@@ -0,0 +1,31 @@
+#include "prop/utility/layout_solver.h"
+
+#include <catch2/catch_all.hpp>
+
+TEST_CASE("Items get their min size when space is short", "[Layout_solver]") {
+	const prop::Layout_constraint constraints[] = {{.min = 10, .preferred = 20}, {.min = 5, .preferred = 50}};
+	REQUIRE(prop::solve_layout(constraints, 0) == std::vector<PROP_SCREEN_UNIT_PRECISION>{10, 5});
+	REQUIRE(prop::solve_layout(constraints, 15) == std::vector<PROP_SCREEN_UNIT_PRECISION>{10, 5});
+}
+
+TEST_CASE("Items grow towards their preferred size proportionally", "[Layout_solver]") {
+	const prop::Layout_constraint constraints[] = {{.min = 10, .preferred = 30}, {.min = 10, .preferred = 20}};
+	REQUIRE(prop::solve_layout(constraints, 35) == std::vector<PROP_SCREEN_UNIT_PRECISION>{20, 15});
+	REQUIRE(prop::solve_layout(constraints, 50) == std::vector<PROP_SCREEN_UNIT_PRECISION>{30, 20});
+}
+
+TEST_CASE("Leftover space is shared up to the max size", "[Layout_solver]") {
+	const prop::Layout_constraint constraints[] = {
+		{.preferred = 10},
+		{.preferred = 10, .max = 15},
+		{.preferred = 10},
+	};
+	REQUIRE(prop::solve_layout(constraints, 60) == std::vector<PROP_SCREEN_UNIT_PRECISION>{22.5, 15, 22.5});
+}
+
+TEST_CASE("Combining constraints", "[Layout_solver]") {
+	const prop::Layout_constraint lhs{.min = 1, .preferred = 2, .max = 3};
+	const prop::Layout_constraint rhs{.min = 2, .preferred = 2, .max = prop::Size<>::max.width};
+	REQUIRE(prop::sequential(lhs, rhs) == prop::Layout_constraint{.min = 3, .preferred = 4, .max = prop::Size<>::max.width});
+	REQUIRE(prop::parallel(lhs, rhs) == prop::Layout_constraint{.min = 2, .preferred = 2, .max = prop::Size<>::max.width});
+}
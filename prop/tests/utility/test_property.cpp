@@ -6,6 +6,7 @@
 #include <catch2/catch_all.hpp>
 #include <memory>
 #include <numeric>
+#include <thread>
 
 static bool _{std::cout << std::unitbuf};
 
@@ -383,6 +384,132 @@ TEST_CASE("Dependency checks", "[Property]") {
 	REQUIRE(p2.is_dependent_on(p1));
 }
 
+TEST_CASE("Repeated reads are captured once", "[Property]") {
+	std::vector<std::unique_ptr<prop::Property<int>>> inputs;
+	for (int i = 0; i < 1000; i++) {
+		inputs.push_back(std::make_unique<prop::Property<int>>(i));
+	}
+	prop::Property<int> explicit_input = 1;
+	std::unique_ptr<prop::Property<int>> inner;
+	prop::Property<int> sum = {
+		[&](int factor) {
+			int result = 0;
+			for (auto &input : inputs) {
+				result += *input + *input;
+			}
+			//a nested binding reading the same properties must not make the outer binding capture them again
+			if (not inner) {
+				inner = std::make_unique<prop::Property<int>>([&] { return *inputs.front() + *inputs.back(); });
+			}
+			result += *inner - *inner;
+			for (auto &input : inputs) {
+				result += *input;
+			}
+			return result * factor * (explicit_input == factor);
+		},
+		explicit_input,
+	};
+	REQUIRE(sum == 3 * 999 * 1000 / 2);
+	REQUIRE(sum.implicit_dependencies == 1001);
+	REQUIRE(sum.explicit_dependencies == 1);
+	REQUIRE(inner->implicit_dependencies == 2);
+	*inputs[5] = 6;
+	REQUIRE(sum == 3 * 999 * 1000 / 2 + 3);
+	REQUIRE(sum.implicit_dependencies == 1001);
+	explicit_input = 2;
+	REQUIRE(sum == 2 * (3 * 999 * 1000 / 2 + 3));
+	REQUIRE(sum.implicit_dependencies == 1001);
+}
+
+TEST_CASE("Reading dependencies in a different order", "[Property]") {
+	prop::Property<bool> reversed = false;
+	prop::Property<int> a = 1;
+	prop::Property<int> b = 2;
+	prop::Property<int> c = 3;
+	prop::Property<int> result = [&] {
+		if (reversed) {
+			return c * 100 + b * 10 + a;
+		}
+		return a * 100 + b * 10;
+	};
+	REQUIRE(result == 120);
+	reversed = true;
+	REQUIRE(result == 321);
+	REQUIRE(result.implicit_dependencies == 4);
+	for (const prop::Property_link *dependency : {&reversed, &a, &b, &c}) {
+		REQUIRE(dependency->is_implicit_dependency_of(result));
+		REQUIRE(dependency->has_dependent(result));
+	}
+	reversed = false;
+	REQUIRE(result == 120);
+	REQUIRE(result.implicit_dependencies == 3);
+	REQUIRE_FALSE(c.has_dependent(result));
+	c = 4;
+	a = 5;
+	REQUIRE(result == 520);
+}
+
+namespace {
+	//not comparable, so only the key tells whether it changed
+	struct Opaque {
+		int value;
+	};
+} // namespace
+
+template <>
+struct prop::Change_key<Opaque> {
+	int operator()(const Opaque &opaque) const {
+		return opaque.value;
+	}
+};
+
+TEST_CASE("Versions only change with the value", "[Property]") {
+	prop::Property<int> number = 1;
+	const auto initial_version = number.get_version();
+	number = 1;
+	REQUIRE(number.get_version() == initial_version);
+	number = 2;
+	const auto changed_version = number.get_version();
+	REQUIRE(changed_version > initial_version);
+	prop::Property<int> other_number = 2;
+	REQUIRE(other_number.get_version() != changed_version);
+
+	prop::Property<Opaque> opaque = Opaque{1};
+	int updates = 0;
+	prop::Property<int> opaque_value = [&] {
+		updates++;
+		return opaque->value;
+	};
+	const auto opaque_version = opaque.get_version();
+	opaque.apply()->value = 1;
+	opaque = Opaque{1};
+	REQUIRE(opaque.get_version() == opaque_version);
+	REQUIRE(updates == 1);
+	opaque.apply()->value = 2;
+	REQUIRE(opaque.get_version() > opaque_version);
+	REQUIRE(updates == 2);
+	REQUIRE(opaque_value == 2);
+}
+
+TEST_CASE("Vectors of Polywraps only change with the objects they hold", "[Property]") {
+	int first = 1;
+	int second = 2;
+	prop::Property<std::vector<prop::Polywrap<int>>> pointers = std::vector<prop::Polywrap<int>>{&first, &second};
+	int updates = 0;
+	prop::Property<void> observer = [&] {
+		pointers.get();
+		updates++;
+	};
+	pointers.apply();
+	*pointers.apply()->front().get() = 3;
+	REQUIRE(updates == 1);
+	pointers = std::vector<prop::Polywrap<int>>{&second, &first};
+	REQUIRE(updates == 2);
+	//new Polywraps hold new objects, even when they are at the address of an old one
+	pointers = std::vector<prop::Polywrap<int>>{&second, &first};
+	REQUIRE(updates == 3);
+}
+
 TEST_CASE("Vectorsum", "[Property]") {
 	prop::Property<std::vector<int>> pv;
 	prop::Property ps = [&pv] { return std::accumulate(std::begin(pv.get()), std::end(pv.get()), 0); };
@@ -733,3 +860,327 @@ TEST_CASE("Void properties", "[Property]") {
 		REQUIRE(counter == 3);
 	}
 }
+
+TEST_CASE("Diamond dependencies update once", "[Property]") {
+	prop::Property a = 1;
+	a.custom_name = "a";
+	prop::Property<int> b = [&a] { return a + 1; };
+	b.custom_name = "b";
+	prop::Property<int> c = [&a] { return a * 2; };
+	c.custom_name = "c";
+	int d_updates = 0;
+	bool glitched = false;
+	prop::Property<int> d = [&] {
+		d_updates++;
+		if (b != a + 1 or c != a * 2) {
+			glitched = true;
+		}
+		return b + c;
+	};
+	d.custom_name = "d";
+	REQUIRE(d == 2 + 2);
+	REQUIRE(d_updates == 1);
+	a = 5;
+	INFO(d.get_status());
+	REQUIRE(d == 6 + 10);
+	REQUIRE(d_updates == 2);
+	REQUIRE(not glitched);
+	prop::Property<int> e = [&] { return b + d; };
+	e.custom_name = "e";
+	a = 6;
+	REQUIRE(e == 7 + 7 + 12);
+	REQUIRE(d_updates == 3);
+	REQUIRE(not glitched);
+}
+
+TEST_CASE("Batching writes", "[Property]") {
+	prop::Property x = 1;
+	prop::Property y = 2;
+	prop::Property z = 3;
+	int sum_updates = 0;
+	prop::Property<int> sum = [&] {
+		sum_updates++;
+		return x + y + z;
+	};
+	REQUIRE(sum == 6);
+	REQUIRE(sum_updates == 1);
+	{
+		prop::Batch batch;
+		x = 10;
+		y = 20;
+		{
+			prop::Batch inner_batch;
+			z = 30;
+		}
+		REQUIRE(sum_updates == 1);
+	}
+	REQUIRE(sum == 60);
+	REQUIRE(sum_updates == 2);
+	prop::batch([&] {
+		x = 100;
+		y = 200;
+		z = 300;
+	});
+	REQUIRE(sum == 600);
+	REQUIRE(sum_updates == 3);
+	{
+		prop::Batch batch;
+		prop::Property w = 4;
+		w.custom_name = "w";
+		prop::Property<int> destroyed_dependent = [&w] { return w; };
+		w = 5;
+	}
+	REQUIRE(sum_updates == 3);
+
+	SECTION("Batches ended by an exception leave their updates pending") {
+		const auto failing_writes = [&] {
+			x = 1;
+			throw std::runtime_error{"batch failed"};
+		};
+		REQUIRE_THROWS_AS(prop::batch(failing_writes), std::runtime_error);
+		REQUIRE(sum == 600);
+		REQUIRE(sum_updates == 3);
+		prop::Batch::flush();
+		REQUIRE(sum == 501);
+		REQUIRE(sum_updates == 4);
+	}
+}
+
+TEST_CASE("Lazy evaluation", "[Property]") {
+	prop::Property a = 1;
+	int lazy_updates = 0;
+	prop::Property<int> lazy = [&] {
+		lazy_updates++;
+		return a * 10;
+	};
+	lazy.set_evaluation_mode(prop::Evaluation_mode::lazy);
+	REQUIRE(lazy_updates == 1);
+	a = 2;
+	a = 3;
+	REQUIRE(lazy.is_stale());
+	REQUIRE(lazy_updates == 1);
+	REQUIRE(lazy == 30);
+	REQUIRE(lazy_updates == 2);
+	REQUIRE(not lazy.is_stale());
+	REQUIRE(lazy == 30);
+	REQUIRE(lazy_updates == 2);
+
+	SECTION("Eager dependents pull lazy dependencies") {
+		prop::Property<int> eager = [&] { return lazy + 1; };
+		REQUIRE(eager == 31);
+		a = 4;
+		REQUIRE(eager == 41);
+		REQUIRE(lazy_updates == 3);
+		REQUIRE(not lazy.is_stale());
+	}
+	SECTION("Lazy dependents of lazy properties stay stale") {
+		int lazy_dependent_updates = 0;
+		prop::Property<int> lazy_dependent = [&] {
+			lazy_dependent_updates++;
+			return lazy + 1;
+		};
+		lazy_dependent.set_evaluation_mode(prop::Evaluation_mode::lazy);
+		a = 4;
+		a = 5;
+		REQUIRE(lazy.is_stale());
+		REQUIRE(lazy_dependent.is_stale());
+		REQUIRE(lazy_dependent == 51);
+		REQUIRE(lazy_updates == 3);
+		REQUIRE(lazy_dependent_updates == 2);
+	}
+	SECTION("Switching back to eager evaluates pending changes") {
+		a = 4;
+		lazy.set_evaluation_mode(prop::Evaluation_mode::eager);
+		REQUIRE(lazy_updates == 3);
+		a = 5;
+		REQUIRE(lazy_updates == 4);
+	}
+	SECTION("Assigning a value discards the pending update") {
+		a = 4;
+		lazy = 7;
+		REQUIRE(not lazy.is_stale());
+		REQUIRE(lazy == 7);
+		REQUIRE(lazy_updates == 2);
+	}
+	SECTION("Assigning the old value discards the pending update") {
+		a = 4;
+		lazy = 30;
+		REQUIRE(not lazy.is_stale());
+		REQUIRE(not lazy.is_bound());
+		REQUIRE(lazy == 30);
+		REQUIRE(lazy_updates == 2);
+	}
+	SECTION("Assigning a stale lazy property copies its current value") {
+		prop::Property<int> copy;
+		a = 4;
+		copy = lazy;
+		REQUIRE(copy == 40);
+		REQUIRE(lazy_updates == 3);
+	}
+	SECTION("Applying a function to a stale lazy property changes its current value") {
+		a = 4;
+		lazy.apply([](int &value) { value++; });
+		REQUIRE(not lazy.is_stale());
+		REQUIRE(lazy == 41);
+	}
+	SECTION("Assigning the current value to an eager binding does nothing") {
+		lazy.set_evaluation_mode(prop::Evaluation_mode::eager);
+		lazy = 30;
+		REQUIRE(lazy.is_bound());
+		a = 4;
+		REQUIRE(lazy == 40);
+	}
+}
+
+TEST_CASE("Bindings whose dependencies did not change are not updated", "[Property]") {
+	prop::Property a = 1;
+	prop::Property<bool> odd = [&] { return a % 2 == 1; };
+	odd.set_evaluation_mode(prop::Evaluation_mode::lazy);
+	int dependent_updates = 0;
+	prop::Property<int> dependent = [&] {
+		dependent_updates++;
+		return odd.get() ? 1 : 0;
+	};
+	int lazy_dependent_updates = 0;
+	prop::Property<int> lazy_dependent = [&] {
+		lazy_dependent_updates++;
+		return odd.get() ? 3 : 2;
+	};
+	lazy_dependent.set_evaluation_mode(prop::Evaluation_mode::lazy);
+	REQUIRE(dependent_updates == 1);
+	REQUIRE(lazy_dependent_updates == 1);
+
+	//odd becomes stale and gets refreshed, but keeps its value
+	a = 3;
+	REQUIRE(dependent_updates == 1);
+	REQUIRE(dependent == 1);
+	REQUIRE(lazy_dependent == 3);
+	REQUIRE(lazy_dependent_updates == 1);
+
+	a = 4;
+	REQUIRE(dependent_updates == 2);
+	REQUIRE(dependent == 0);
+	REQUIRE(lazy_dependent == 2);
+	REQUIRE(lazy_dependent_updates == 2);
+}
+
+TEST_CASE("Properties with many dependents", "[Property]") {
+	prop::Property hub = 1;
+	std::vector<std::unique_ptr<prop::Property<int>>> dependents;
+	for (int i = 0; i < 3 * PROP_DEPENDENT_INDEX_THRESHOLD; i++) {
+		dependents.push_back(std::make_unique<prop::Property<int>>([&hub, i] { return hub + i; }));
+	}
+	for (auto &dependent : dependents) {
+		REQUIRE(hub.is_dependency_of(*dependent));
+		REQUIRE(dependent->is_dependent_on(hub));
+	}
+	for (std::size_t i = 0; i < std::size(dependents); i += 2) {
+		dependents[i].reset();
+	}
+	std::erase(dependents, nullptr);
+	hub = 10;
+	for (auto &dependent : dependents) {
+		REQUIRE(hub.is_dependency_of(*dependent));
+	}
+	prop::Property moved_hub = std::move(hub);
+	REQUIRE(dependents.front()->is_dependent_on(moved_hub));
+	REQUIRE(not dependents.front()->is_dependent_on(hub));
+	while (std::size(dependents) > 1) {
+		dependents.pop_back();
+	}
+	moved_hub = 20;
+	REQUIRE(*dependents.front() == 21);
+	REQUIRE(moved_hub.is_dependency_of(*dependents.front()));
+}
+
+TEST_CASE("Independent properties on multiple threads", "[Property]") {
+	std::vector<int> results(4);
+	std::vector<std::thread> threads;
+	for (std::size_t thread_index = 0; thread_index < std::size(results); thread_index++) {
+		threads.emplace_back([&result = results[thread_index], thread_index] {
+			prop::Property source = 0;
+			prop::Property<int> doubled = [&source] { return source * 2; };
+			prop::Property<int> sum = [&] { return source + doubled; };
+			for (int i = 0; i < 1000; i++) {
+				source = i + static_cast<int>(thread_index);
+			}
+			result = sum;
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	for (std::size_t thread_index = 0; thread_index < std::size(results); thread_index++) {
+		REQUIRE(results[thread_index] == 3 * (999 + static_cast<int>(thread_index)));
+	}
+}
+
+TEST_CASE("Writing shared properties from a worker thread", "[Property]") {
+	prop::Property model = 0;
+	prop::Property<int> view = [&model] { return model + 1; };
+	std::thread worker{[&model] {
+		for (int i = 1; i <= 100; i++) {
+			prop::Graph_lock lock;
+			model = i;
+		}
+	}};
+	worker.join();
+	prop::Graph_lock lock;
+	REQUIRE(view == 101);
+}
+
+TEST_CASE("Parallel propagation", "[Property]") {
+	const auto previous_settings = prop::get_parallel_propagation();
+	prop::set_parallel_propagation({.enabled = true, .minimum_fan_out = 4, .threads = 4});
+	prop::detail::RAII restore_settings{[&previous_settings] { prop::set_parallel_propagation(previous_settings); }};
+
+	prop::Property source = 1;
+	std::vector<std::unique_ptr<prop::Property<int>>> siblings;
+	for (int i = 0; i < 64; i++) {
+		siblings.push_back(std::make_unique<prop::Property<int>>([&source, i] { return source * i; }));
+	}
+	int sum_updates = 0;
+	prop::Property<int> sum = [&] {
+		sum_updates++;
+		int result = 0;
+		for (auto &sibling : siblings) {
+			result += *sibling;
+		}
+		return result;
+	};
+	REQUIRE(sum == 63 * 64 / 2);
+	source = 2;
+	REQUIRE(sum == 63 * 64);
+	REQUIRE(sum_updates == 2);
+	for (int i = 0; i < 64; i++) {
+		REQUIRE(*siblings[static_cast<std::size_t>(i)] == 2 * i);
+	}
+
+	SECTION("Exceptions are rethrown on the writing thread") {
+		siblings[7] = std::make_unique<prop::Property<int>>([&source]() -> int {
+			if (source == 3) {
+				throw std::runtime_error{"source must not be 3"};
+			}
+			return 0;
+		});
+		REQUIRE_THROWS_AS(source = 3, std::runtime_error);
+		source = 4;
+		REQUIRE(*siblings[8] == 32);
+	}
+	SECTION("Shared lazy dependencies are refreshed once") {
+		int shared_updates = 0;
+		prop::Property<int> shared = [&] {
+			shared_updates++;
+			return source * 10;
+		};
+		shared.set_evaluation_mode(prop::Evaluation_mode::lazy);
+		for (int i = 0; i < 64; i++) {
+			siblings[static_cast<std::size_t>(i)] =
+				std::make_unique<prop::Property<int>>([&shared, i] { return shared + i; });
+		}
+		shared_updates = 0;
+		source = 3;
+		REQUIRE(shared_updates == 1);
+		REQUIRE(*siblings[63] == 93);
+	}
+}
@@ -8,3 +8,17 @@ TEST_CASE("Aggregate construction") {
 
 	[[maybe_unused]] constexpr prop::Size size{.width = 800, .height = 600};
 }
+
+TEST_CASE("Intersection and union") {
+	constexpr prop::Rect<int> a{.top = 0, .left = 0, .bottom = 10, .right = 10};
+	constexpr prop::Rect<int> b{.top = 5, .left = 5, .bottom = 20, .right = 20};
+	constexpr prop::Rect<int> c{.top = 10, .left = 0, .bottom = 20, .right = 10};
+	static_assert(prop::intersects(a, b));
+	static_assert(not prop::intersects(a, c));
+	static_assert(prop::united(a, b) == prop::Rect<int>{.top = 0, .left = 0, .bottom = 20, .right = 20});
+	static_assert(prop::united(a, prop::Rect<int>{}) == a);
+	static_assert(prop::intersected(a, b) == prop::Rect<int>{.top = 5, .left = 5, .bottom = 10, .right = 10});
+	static_assert(prop::is_empty(prop::intersected(a, c)));
+	static_assert(prop::is_empty(prop::Rect<int>{}));
+	static_assert(not prop::is_empty(a));
+}
@@ -0,0 +1,49 @@
+#include "prop/utility/small_function.h"
+
+#include <array>
+#include <catch2/catch_all.hpp>
+#include <memory>
+
+TEST_CASE("Small_function calls its callable", "[Small_function]") {
+	prop::Small_function<int(int), 32> f;
+	REQUIRE(not f);
+	REQUIRE(f == nullptr);
+	f = [](int i) { return i + 1; };
+	REQUIRE(f);
+	REQUIRE(f(41) == 42);
+	f = nullptr;
+	REQUIRE(not f);
+	int (*null_function)(int) = nullptr;
+	f = null_function;
+	REQUIRE(not f);
+}
+
+TEST_CASE("Small_function stores move-only and large callables", "[Small_function]") {
+	auto counter = std::make_shared<int>(0);
+	{
+		prop::Small_function<int(), 32> small = [p = std::make_unique<int>(5), counter] { return *p + ++*counter; };
+		std::array<int, 64> big_data{};
+		big_data[63] = 10;
+		prop::Small_function<int(), 32> big = [big_data, counter] { return big_data[63] + ++*counter; };
+		REQUIRE(counter.use_count() == 3);
+		REQUIRE(small() == 6);
+		REQUIRE(big() == 12);
+		auto moved_small = std::move(small);
+		auto moved_big = std::move(big);
+		REQUIRE(not small);
+		REQUIRE(not big);
+		REQUIRE(moved_small() == 8);
+		REQUIRE(moved_big() == 14);
+		std::swap(moved_small, moved_big);
+		REQUIRE(moved_small() == 15);
+		REQUIRE(counter.use_count() == 3);
+	}
+	REQUIRE(counter.use_count() == 1);
+}
+
+TEST_CASE("Small_function passes references", "[Small_function]") {
+	prop::Small_function<void(int &), 16> increment = [](int &i) { i++; };
+	int value = 1;
+	increment(value);
+	REQUIRE(value == 2);
+}
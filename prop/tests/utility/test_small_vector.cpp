@@ -0,0 +1,60 @@
+#include "prop/utility/small_vector.h"
+
+#include <catch2/catch_all.hpp>
+#include <span>
+#include <vector>
+
+TEST_CASE("Small_vector stays inline until it exceeds its inline capacity", "[Small_vector]") {
+	prop::Small_vector<int, 3> v;
+	REQUIRE(v.empty());
+	REQUIRE(v.is_inline());
+	v.push_back(1);
+	v.push_back(2);
+	v.push_back(3);
+	REQUIRE(v.is_inline());
+	REQUIRE(v.size() == 3);
+	v.push_back(4);
+	REQUIRE(not v.is_inline());
+	REQUIRE(v == prop::Small_vector<int, 3>{1, 2, 3, 4});
+	v.clear();
+	REQUIRE(v.empty());
+	REQUIRE(not v.is_inline());
+}
+
+TEST_CASE("Small_vector insert and erase", "[Small_vector]") {
+	prop::Small_vector<int, 2> v{1, 4};
+	v.insert(std::begin(v) + 1, 3);
+	v.insert(std::begin(v) + 1, 2);
+	REQUIRE(v == prop::Small_vector<int, 2>{1, 2, 3, 4});
+	const std::vector<int> tail{5, 6, 7};
+	v.insert(std::end(v), std::begin(tail), std::end(tail));
+	REQUIRE(v == prop::Small_vector<int, 2>{1, 2, 3, 4, 5, 6, 7});
+	v.insert(std::begin(v), v[6]);
+	REQUIRE(v == prop::Small_vector<int, 2>{7, 1, 2, 3, 4, 5, 6, 7});
+	v.erase(std::begin(v));
+	v.erase(std::begin(v) + 1, std::begin(v) + 3);
+	REQUIRE(v == prop::Small_vector<int, 2>{1, 4, 5, 6, 7});
+	std::span<const int> span = v;
+	REQUIRE(span.size() == 5);
+	REQUIRE(span.back() == 7);
+}
+
+TEST_CASE("Small_vector copy, move and swap", "[Small_vector]") {
+	prop::Small_vector<int, 2> small{1, 2};
+	prop::Small_vector<int, 2> large{1, 2, 3, 4};
+	auto small_copy = small;
+	auto large_copy = large;
+	REQUIRE(small_copy == small);
+	REQUIRE(large_copy == large);
+	auto moved_small = std::move(small_copy);
+	auto moved_large = std::move(large_copy);
+	REQUIRE(moved_small.is_inline());
+	REQUIRE(not moved_large.is_inline());
+	REQUIRE(small_copy.empty());
+	REQUIRE(large_copy.empty());
+	REQUIRE(large_copy.is_inline());
+	using std::swap;
+	swap(moved_small, moved_large);
+	REQUIRE(moved_small == large);
+	REQUIRE(moved_large == small);
+}
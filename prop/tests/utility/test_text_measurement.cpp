@@ -0,0 +1,66 @@
+#include "prop/utility/text_measurement.h"
+
+#include <catch2/catch_all.hpp>
+#include <string>
+#include <vector>
+
+TEST_CASE("Repeated measurements are cached", "[Text_measurement_cache]") {
+	int measurements = 0;
+	prop::Text_measurement_cache cache{16, [&measurements](std::string_view text, const prop::Font &font) {
+										   measurements++;
+										   return prop::Size<>{.width = static_cast<float>(std::size(text)),
+															   .height = font.bold ? 2.f : 1.f};
+									   }};
+	prop::Font font;
+	REQUIRE(cache.measure("Running", font) == prop::Size<>{.width = 7, .height = 1});
+	REQUIRE(cache.measure("Running", font) == prop::Size<>{.width = 7, .height = 1});
+	REQUIRE(measurements == 1);
+	auto colored_font = font.with({.color = prop::Color::red});
+	REQUIRE(cache.measure("Running", colored_font) == prop::Size<>{.width = 7, .height = 1});
+	REQUIRE(measurements == 1);
+	auto bold_font = font.with({.bold = true});
+	REQUIRE(cache.measure("Running", bold_font) == prop::Size<>{.width = 7, .height = 2});
+	REQUIRE(measurements == 2);
+	auto statistics = cache.get_statistics();
+	REQUIRE(statistics.hits == 2);
+	REQUIRE(statistics.misses == 2);
+	REQUIRE(statistics.evictions == 0);
+}
+
+TEST_CASE("Least recently used measurements are evicted", "[Text_measurement_cache]") {
+	std::vector<std::string> measured;
+	prop::Text_measurement_cache cache{2, [&measured](std::string_view text, const prop::Font &) {
+										   measured.emplace_back(text);
+										   return prop::Size<>{};
+									   }};
+	prop::Font font;
+	cache.measure("a", font);
+	cache.measure("b", font);
+	cache.measure("a", font);
+	cache.measure("c", font);
+	REQUIRE(cache.size() == 2);
+	REQUIRE(cache.get_statistics().evictions == 1);
+	cache.measure("a", font);
+	cache.measure("b", font);
+	REQUIRE(measured == std::vector<std::string>{"a", "b", "c", "b"});
+	cache.set_capacity(1);
+	REQUIRE(cache.size() == 1);
+	cache.clear();
+	REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("Batch measurements", "[Text_measurement_cache]") {
+	int measurements = 0;
+	prop::Text_measurement_cache cache{16, [&measurements](std::string_view text, const prop::Font &) {
+										   measurements++;
+										   return prop::Size<>{.width = static_cast<float>(std::size(text))};
+									   }};
+	const std::vector<std::string> cells{"ok", "failed", "ok", "ok", "pending", "failed"};
+	auto sizes = cache.measure(cells, prop::Font{});
+	REQUIRE(std::size(sizes) == std::size(cells));
+	for (std::size_t i = 0; i < std::size(cells); i++) {
+		REQUIRE(sizes[i].width == std::size(cells[i]));
+	}
+	REQUIRE(measurements == 3);
+	REQUIRE(cache.get_statistics().hits == 3);
+}
@@ -0,0 +1,84 @@
+#include "prop/utility/property.h"
+#include "prop/utility/vector_change.h"
+
+#include <catch2/catch_all.hpp>
+
+TEST_CASE("Vector change log", "[Vector_change]") {
+	prop::Vector_change_log log;
+	REQUIRE(log.changes_since(log.get_version())->empty());
+	REQUIRE_FALSE(log.changes_since(prop::Vector_change_log::no_version));
+	const auto start = log.get_version();
+	log.record({.type = prop::Vector_change::Type::insert, .index = 3});
+	log.record({.type = prop::Vector_change::Type::move, .index = 5, .to = 1});
+	REQUIRE(std::size(*log.changes_since(start)) == 2);
+	REQUIRE(prop::first_changed_index(*log.changes_since(start)) == 1);
+	REQUIRE(prop::first_changed_index(*log.changes_since(start + 1)) == 1);
+	log.reset();
+	REQUIRE_FALSE(log.changes_since(start));
+	REQUIRE(log.changes_since(log.get_version())->empty());
+
+	const auto before_many = log.get_version();
+	for (int i = 0; i < 2 * PROP_VECTOR_CHANGE_LOG_CAPACITY; i++) {
+		log.record({.type = prop::Vector_change::Type::update, .index = 0});
+	}
+	REQUIRE_FALSE(log.changes_since(before_many));
+	REQUIRE(std::size(*log.changes_since(log.get_version() - 1)) == 1);
+}
+
+TEST_CASE("Structural changes of vector properties", "[Vector_change]") {
+	prop::Property<std::vector<int>> numbers = std::vector{1, 2, 3};
+	auto seen_version = prop::Vector_change_log::no_version;
+	std::size_t first_changed = 0;
+	prop::Property<int> sum = [&] {
+		const auto &log = numbers.get_changes();
+		const auto changes = log.changes_since(seen_version);
+		seen_version = log.get_version();
+		first_changed = changes ? prop::first_changed_index(*changes) : 0;
+		int result = 0;
+		for (auto number : numbers.get()) {
+			result += number;
+		}
+		return result;
+	};
+	REQUIRE(sum == 6);
+
+	numbers.emplace_back(4);
+	REQUIRE(sum == 10);
+	REQUIRE(first_changed == 3);
+	numbers.emplace(1, 10);
+	REQUIRE(numbers.get() == std::vector{1, 10, 2, 3, 4});
+	REQUIRE(first_changed == 1);
+	numbers.move(4, 2);
+	REQUIRE(numbers.get() == std::vector{1, 10, 4, 2, 3});
+	REQUIRE(first_changed == 2);
+	numbers.move(1, 3);
+	REQUIRE(numbers.get() == std::vector{1, 4, 2, 10, 3});
+	REQUIRE(first_changed == 1);
+	numbers.apply_at(4, [](int &number) { number = 5; });
+	REQUIRE(sum == 22);
+	REQUIRE(first_changed == 4);
+	numbers.erase(2, 2);
+	REQUIRE(numbers.get() == std::vector{1, 4, 5});
+	REQUIRE(first_changed == 2);
+
+	numbers.apply()->push_back(6);
+	REQUIRE(sum == 16);
+	REQUIRE(first_changed == 0);
+}
+
+TEST_CASE("Structural changes of stale lazy vectors", "[Vector_change]") {
+	prop::Property size = 2;
+	prop::Property<std::vector<int>> numbers = [&] { return std::vector<int>(static_cast<std::size_t>(size.get()), 1); };
+	numbers.set_evaluation_mode(prop::Evaluation_mode::lazy);
+	size = 3;
+	REQUIRE(numbers.is_stale());
+	numbers.emplace_back(2);
+	REQUIRE(not numbers.is_stale());
+	REQUIRE(numbers.get() == std::vector{1, 1, 1, 2});
+	size = 1;
+	numbers.apply_at(0, [](int &number) { number = 3; });
+	REQUIRE(numbers.get() == std::vector{3});
+	size = 2;
+	numbers.apply()->push_back(4);
+	REQUIRE(numbers.get() == std::vector{1, 1, 4});
+}
@@ -0,0 +1,104 @@
+#include "grid_layout.h"
+#include "prop/utility/canvas.h"
+#include "prop/utility/dependency_tracer.h"
+#include "prop/utility/tracking_pointer.h"
+
+#include <boost/pfr/tuple_size.hpp>
+#ifdef PROPERTY_NAMES
+#include <string_view>
+#endif
+
+#define PROP_GRID_LAYOUT_PARAMETER_MEMBERS PROP_X(columns), PROP_X(children)
+#define PROP_GRID_LAYOUT_PROPERTY_MEMBERS                                                                              \
+	PROP_X(columns), PROP_X(children), PROP_X(constraints), PROP_X(cells), PROP_X(cell_binder)
+
+prop::Grid_layout::Grid_layout()
+	: Grid_layout{Parameters{}} {}
+
+prop::Grid_layout::Grid_layout(Parameters parameters)
+	: prop::Widget{std::move(parameters.widget)}
+#define PROP_X(X)                                                                                                      \
+	X {                                                                                                                \
+		std::move(parameters.X)                                                                                        \
+	}
+	, PROP_GRID_LAYOUT_PARAMETER_MEMBERS
+#undef PROP_X
+	, constraints{[self_pointer = prop::track(this)] {
+		return prop::grid_constraints(self_pointer->children.get(), self_pointer->columns.get());
+	}}
+	, cells{[self_pointer = prop::track(this)] {
+		const auto &area = self_pointer->position.get();
+		return prop::grid_cells(self_pointer->children.get(), self_pointer->columns.get(),
+								{.width = area.right - area.left, .height = area.bottom - area.top});
+	}}
+	, cell_binder{[self_pointer = prop::track(this)] mutable {
+		auto &self = *self_pointer;
+		const auto &children_ = self.children.get();
+		for (std::size_t i = 0; i < std::size(children_); i++) {
+			prop::bind_to_cell(*children_[i].get(), i, self.cells);
+		}
+	}} {
+	static_assert(boost::pfr::tuple_size_v<prop::Grid_layout::Parameters> == 3, "Add missing parameters");
+	//the sizes are bindings instead of being written by the layout, so a parent layout is updated after this one's
+	//sizes and before this one's cells, and the cells are only solved once per change
+	min_size = {[](const prop::Layout_constraints &constraints_) {
+					return prop::Size<>{constraints_.width.min, constraints_.height.min};
+				},
+				constraints};
+	preferred_size = {[](const prop::Layout_constraints &constraints_) {
+						  return prop::Size<>{constraints_.width.preferred, constraints_.height.preferred};
+					  },
+					  constraints};
+	max_size = {[](const prop::Layout_constraints &constraints_) {
+					return prop::Size<>{constraints_.width.max, constraints_.height.max};
+				},
+				constraints};
+#ifdef PROPERTY_NAMES
+	set_name("<Grid_layout>");
+#endif
+}
+
+prop::Grid_layout::Grid_layout(Grid_layout &&other) noexcept {
+	swap(*this, other);
+}
+
+prop::Grid_layout::~Grid_layout() = default;
+
+prop::Grid_layout &prop::Grid_layout::operator=(Grid_layout &&other) noexcept {
+	swap(*this, other);
+	return *this;
+}
+
+void prop::Grid_layout::draw(prop::Canvas canvas) const {
+	for (const auto &child : children.get()) {
+		canvas.draw_widget(*child.get());
+	}
+}
+
+#ifdef PROPERTY_NAMES
+void prop::Grid_layout::set_name(std::string_view name) {
+#define PROP_X(MEMBER) MEMBER.custom_name = std::string{name} + "." + #MEMBER
+	(PROP_GRID_LAYOUT_PROPERTY_MEMBERS);
+#undef PROP_X
+	prop::Widget::set_name(name);
+}
+
+void prop::Grid_layout::trace(Dependency_tracer &dependency_tracer) const {
+	prop::Dependency_tracer::Make_current _{*this, dependency_tracer};
+#define PROP_X(X) PROP_TRACE(dependency_tracer, X)
+	(PROP_GRID_LAYOUT_PROPERTY_MEMBERS);
+#undef PROP_X
+	for (const auto &child : children.get()) {
+		dependency_tracer.trace(*child.get());
+	}
+	prop::Widget::trace(dependency_tracer);
+}
+#endif
+
+void prop::swap(Grid_layout &lhs, Grid_layout &rhs) {
+	using std::swap;
+#define PROP_X(MEMBER) swap(lhs.MEMBER, rhs.MEMBER)
+	(PROP_GRID_LAYOUT_PROPERTY_MEMBERS);
+#undef PROP_X
+	swap(static_cast<prop::Widget &>(lhs), static_cast<prop::Widget &>(rhs));
+}
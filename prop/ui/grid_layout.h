@@ -0,0 +1,48 @@
+#pragma once
+
+#include "prop/ui/widget.h"
+#include "prop/utility/dependency_tracer.h"
+#include "prop/utility/layout_solver.h"
+#include "prop/utility/polywrap.h"
+#include "prop/utility/property.h"
+
+#include <cstddef>
+#include <vector>
+#ifdef PROPERTY_NAMES
+#include <string_view>
+#endif
+
+namespace prop {
+	void swap(class Grid_layout &lhs, class Grid_layout &rhs);
+
+	//Places its children in rows of columns cells, row by row. Columns share the layout's width according to the min,
+	//preferred and max widths of their children, rows share its height the same way. Children fill their cell within
+	//their min and max size.
+	class Grid_layout : public prop::Widget {
+		public:
+		struct Parameters {
+			prop::Property<std::size_t> columns = 1;
+			prop::Property<std::vector<prop::Polywrap<prop::Widget>>> children;
+			prop::Widget::Parameters widget = {};
+		};
+		Grid_layout();
+		Grid_layout(Parameters parameters);
+		Grid_layout(Grid_layout &&other) noexcept;
+		~Grid_layout() override;
+		Grid_layout &operator=(Grid_layout &&other) noexcept;
+		void draw(prop::Canvas canvas) const override;
+		friend void swap(Grid_layout &lhs, Grid_layout &rhs);
+#ifdef PROPERTY_NAMES
+		void set_name(std::string_view name) override;
+		void trace(Dependency_tracer &dependency_tracer) const override;
+#endif
+
+		prop::Property<std::size_t> columns;
+		prop::Property<std::vector<prop::Polywrap<prop::Widget>>> children;
+
+		private:
+		prop::Property<prop::Layout_constraints> constraints;
+		prop::Property<std::vector<prop::Layout_cell>> cells;
+		prop::Property<void> cell_binder;
+	};
+} // namespace prop
@@ -1,24 +1,37 @@
 #pragma once
 
-#include "../utility/font.h"
-#include "widget.h"
+#include "prop/ui/grid_layout.h"
+#include "prop/ui/widget.h"
+#include "prop/utility/polywrap.h"
 
-#include <memory>
-#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace prop {
-	class Label : public prop::Widget {
+	//Places its children from left to right. Children get at least their min width and share the rest of the width
+	//according to their preferred and max widths. They are as high as the layout, within their min and max height.
+	//It is a Grid_layout with a single row, columns is bound to the number of children.
+	class Horizontal_layout : public prop::Grid_layout {
 		public:
-		Label(std::string text = {});
-		Label(Label &&other);
-		Label &operator=(Label &&other);
-		~Label();
-
-		void update() override;
-		friend void swap(Label &lhs, Label &rhs);
-
-		prop::Property<std::string> text;
-		prop::Property<prop::Font> font;
-		std::unique_ptr<struct Label_privates> privates;
+		Horizontal_layout();
+		template <class... Children>
+		Horizontal_layout(Children &&...children)
+			requires(std::is_convertible_v<decltype(std::forward<Children>(children)), prop::Polywrap<prop::Widget>> and
+					 ...);
+		Horizontal_layout(Horizontal_layout &&other) noexcept;
+		~Horizontal_layout() override;
+		Horizontal_layout &operator=(Horizontal_layout &&other) noexcept;
 	};
 } // namespace prop
+
+//implementation
+template <class... Children>
+prop::Horizontal_layout::Horizontal_layout(Children &&...children_)
+	requires(std::is_convertible_v<decltype(std::forward<Children>(children_)), prop::Polywrap<prop::Widget>> and ...)
+	: Horizontal_layout{} {
+	std::vector<prop::Polywrap<prop::Widget>> children_list;
+	children_list.reserve(sizeof...(children_));
+	(children_list.emplace_back(std::forward<Children>(children_)), ...);
+	children = std::move(children_list);
+}
@@ -1,6 +1,6 @@
 #include "label.h"
-#include "prop/platform/platform.h"
 #include "prop/utility/canvas.h"
+#include "prop/utility/text_measurement.h"
 #include "prop/utility/tracking_pointer.h"
 #include "prop/utility/utility.h"
 
@@ -26,7 +26,7 @@ prop::Label::Label(Parameters parameters)
 	assert(not font->name.empty());
 	preferred_size = [self = prop::track(this)] {
 		assert(not self->font->name.empty());
-		return prop::platform::canvas::text_size(self->text, self->font);
+		return prop::measure_text(self->text, self->font);
 	};
 	min_size = [this] -> prop::Size<> { return preferred_size; };
 }
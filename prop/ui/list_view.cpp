@@ -0,0 +1,142 @@
+#include "list_view.h"
+#include "prop/utility/canvas.h"
+#include "prop/utility/dependency_tracer.h"
+#include "prop/utility/tracking_pointer.h"
+
+#include <algorithm>
+#include <boost/pfr/tuple_size.hpp>
+#include <cmath>
+#ifdef PROPERTY_NAMES
+#include <string_view>
+#endif
+
+#define PROP_LIST_VIEW_PARAMETER_MEMBERS                                                                               \
+	PROP_X(item_count), PROP_X(row_height), PROP_X(scroll_offset), PROP_X(overscan), PROP_X(row_factory)
+#define PROP_LIST_VIEW_PROPERTY_MEMBERS                                                                                \
+	PROP_X(item_count), PROP_X(row_height), PROP_X(scroll_offset), PROP_X(overscan), PROP_X(row_count),                \
+		PROP_X(row_updater)
+
+prop::List_view::List_view()
+	: List_view{Parameters{}} {}
+
+prop::List_view::List_view(Parameters parameters)
+	: prop::Widget{std::move(parameters.widget)}
+#define PROP_X(X)                                                                                                      \
+	X {                                                                                                                \
+		std::move(parameters.X)                                                                                        \
+	}
+	, PROP_LIST_VIEW_PARAMETER_MEMBERS
+#undef PROP_X
+	, row_count{0}
+	, row_updater{[self_pointer = prop::track(this)] mutable { self_pointer->update_rows(); }} {
+	static_assert(boost::pfr::tuple_size_v<prop::List_view::Parameters> == 6, "Add missing parameters");
+#ifdef PROPERTY_NAMES
+	set_name("<List_view>");
+#endif
+}
+
+prop::List_view::List_view(List_view &&other) noexcept {
+	swap(*this, other);
+}
+
+prop::List_view::~List_view() = default;
+
+prop::List_view &prop::List_view::operator=(List_view &&other) noexcept {
+	swap(*this, other);
+	return *this;
+}
+
+void prop::List_view::draw(prop::Canvas canvas) const {
+	//reading row_count makes recordings depend on the set of rows, their positions are read by draw_widget
+	row_count.get();
+	for (const auto &row : rows) {
+		canvas.draw_widget(*row->widget.get());
+	}
+}
+
+void prop::List_view::scroll_to(std::size_t item) {
+	scroll_offset = static_cast<PROP_SCREEN_UNIT_PRECISION>(item) * row_height.get();
+}
+
+const prop::Widget *prop::List_view::get_row(std::size_t item) const {
+	if (rows.empty()) {
+		return nullptr;
+	}
+	const auto &row = *rows[item % std::size(rows)];
+	return row.index.get() == item ? row.widget.get() : nullptr;
+}
+
+void prop::List_view::update_rows() {
+	const auto count = item_count.get();
+	const auto height = row_height.get();
+	const auto offset = std::max<PROP_SCREEN_UNIT_PRECISION>(scroll_offset.get(), 0);
+	const auto &area = position.get();
+	const auto visible_height = std::max<PROP_SCREEN_UNIT_PRECISION>(area.bottom - area.top, 0);
+	std::size_t first = 0;
+	std::size_t last = 0;
+	if (height > 0 and row_factory) {
+		const auto row_at = [count](double y) {
+			return static_cast<std::size_t>(std::min(std::max(y, 0.), static_cast<double>(count)));
+		};
+		const auto first_visible = row_at(std::floor(offset / height));
+		const auto last_visible = row_at(std::ceil((offset + visible_height) / height));
+		const auto extra_rows = overscan.get();
+		first = first_visible - std::min(first_visible, extra_rows);
+		last = last_visible + std::min(count - last_visible, extra_rows);
+	}
+	const auto needed = last - first;
+	//rows are only created or destroyed when the number of rows changes, otherwise they are reused for other items
+	while (std::size(rows) > needed) {
+		rows.pop_back();
+	}
+	rows.reserve(needed);
+	while (std::size(rows) < needed) {
+		auto &row = *rows.emplace_back(std::make_unique<Row>());
+		const auto slot = std::size(rows) - 1;
+		row.index = first + (slot + needed - first % needed) % needed;
+		row.widget = row_factory(row.index);
+	}
+	for (auto item = first; item < last; item++) {
+		auto &row = *rows[item % needed];
+		//assigning an equal index or position does not notify, so rows that still show the same item stay untouched
+		row.index = item;
+		const auto top = static_cast<PROP_SCREEN_UNIT_PRECISION>(static_cast<double>(item) * height - offset);
+		row.widget->position = prop::Rect<>{
+			.top = top,
+			.left = 0,
+			.bottom = top + height,
+			.right = area.right - area.left,
+		};
+	}
+	row_count = needed;
+}
+
+#ifdef PROPERTY_NAMES
+void prop::List_view::set_name(std::string_view name) {
+#define PROP_X(MEMBER) MEMBER.custom_name = std::string{name} + "." + #MEMBER
+	(PROP_LIST_VIEW_PROPERTY_MEMBERS);
+#undef PROP_X
+	prop::Widget::set_name(name);
+}
+
+void prop::List_view::trace(Dependency_tracer &dependency_tracer) const {
+	prop::Dependency_tracer::Make_current _{*this, dependency_tracer};
+#define PROP_X(X) PROP_TRACE(dependency_tracer, X)
+	(PROP_LIST_VIEW_PROPERTY_MEMBERS);
+#undef PROP_X
+	for (const auto &row : rows) {
+		dependency_tracer.trace(*row->widget.get());
+	}
+	prop::Widget::trace(dependency_tracer);
+}
+#endif
+
+void prop::swap(List_view &lhs, List_view &rhs) {
+	using std::swap;
+#define PROP_X(MEMBER) swap(lhs.MEMBER, rhs.MEMBER)
+	(PROP_LIST_VIEW_PROPERTY_MEMBERS);
+#undef PROP_X
+	swap(lhs.row_factory, rhs.row_factory);
+	swap(lhs.rows, rhs.rows);
+	swap(static_cast<prop::Widget &>(lhs), static_cast<prop::Widget &>(rhs));
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "prop/ui/widget.h"
+#include "prop/utility/polywrap.h"
+#include "prop/utility/property.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#ifdef PROPERTY_NAMES
+#include <string_view>
+#endif
+
+namespace prop {
+	void swap(class List_view &lhs, class List_view &rhs);
+
+	//Vertical list of item_count rows of row_height each. Only the rows that are visible, plus overscan rows above
+	//and below, exist as widgets. A row is created by row_factory once and shows the item at its index, which changes
+	//when the row is reused for another item while scrolling.
+	class List_view : public prop::Widget {
+		public:
+		using Row_factory = std::function<prop::Polywrap<prop::Widget>(const prop::Property<std::size_t> &index)>;
+		struct Parameters {
+			prop::Property<std::size_t> item_count = 0;
+			prop::Property<PROP_SCREEN_UNIT_PRECISION> row_height = 20;
+			prop::Property<PROP_SCREEN_UNIT_PRECISION> scroll_offset = 0;
+			prop::Property<std::size_t> overscan = 2;
+			Row_factory row_factory = {};
+			prop::Widget::Parameters widget = {};
+		};
+		List_view();
+		List_view(Parameters parameters);
+		List_view(List_view &&other) noexcept;
+		~List_view() override;
+		List_view &operator=(List_view &&other) noexcept;
+		void draw(prop::Canvas canvas) const override;
+		friend void swap(List_view &lhs, List_view &rhs);
+#ifdef PROPERTY_NAMES
+		void set_name(std::string_view name) override;
+		void trace(Dependency_tracer &dependency_tracer) const override;
+#endif
+
+		//sets scroll_offset so that item is the first visible row
+		void scroll_to(std::size_t item);
+		//number of rows that currently exist as widgets
+		const prop::Property<std::size_t> &get_row_count() const {
+			return row_count;
+		}
+		//the row showing item or nullptr if item is not close enough to the visible area
+		const prop::Widget *get_row(std::size_t item) const;
+
+		prop::Property<std::size_t> item_count;
+		prop::Property<PROP_SCREEN_UNIT_PRECISION> row_height;
+		prop::Property<PROP_SCREEN_UNIT_PRECISION> scroll_offset;
+		prop::Property<std::size_t> overscan;
+		Row_factory row_factory;
+
+		private:
+		struct Row {
+			prop::Property<std::size_t> index;
+			//declared after index because the widget's bindings may refer to it
+			prop::Polywrap<prop::Widget> widget;
+		};
+		void update_rows();
+		//the row for item i is rows[i % size(rows)], so scrolling by one row only changes the index of one row
+		std::vector<std::unique_ptr<Row>> rows;
+		prop::Property<std::size_t> row_count;
+		prop::Property<void> row_updater;
+	};
+} // namespace prop
@@ -3,6 +3,7 @@
 #include "prop/utility/dependency_tracer.h"
 #include "prop/utility/tracking_pointer.h"
 
+#include <algorithm>
 #include <cassert>
 #ifdef PROPERTY_NAMES
 #include <string_view>
@@ -13,49 +14,84 @@
 #endif
 
 #define PROP_VERTICAL_LAYOUT_PROPERTY_MEMBERS                                                                          \
-	PROP_X(name_updater), PROP_X(children), PROP_X(alignment), PROP_X(child_positioner)
+	PROP_X(name_updater), PROP_X(children), PROP_X(alignment), PROP_X(layout_origin), PROP_X(size_updater),            \
+		PROP_X(child_positioner)
 
 prop::Vertical_layout::Vertical_layout()
-	: child_positioner{[self_pointer = prop::track(this)] mutable {
-		//return;
-		self_pointer->children.apply([&self = *self_pointer](std::vector<prop::Polywrap<prop::Widget>> &children_) {
-			if (children_.empty()) {
-				self.min_size = prop::Size<>{0, 0};
-				self.max_size = prop::Size<>::max;
-				self.preferred_size = prop::Size<>{0, 0};
-				return;
-			}
-			PROP_SCREEN_UNIT_PRECISION min_width = 0;
-			PROP_SCREEN_UNIT_PRECISION min_height = 0;
-			PROP_SCREEN_UNIT_PRECISION max_width = 0;
-			PROP_SCREEN_UNIT_PRECISION max_height = 0;
-			PROP_SCREEN_UNIT_PRECISION ypos = 0;
-			const PROP_SCREEN_UNIT_PRECISION width = self.position->width();
-			for (auto &child : children_) {
-				//TODO: Don't just go with minimum size, instead take actual size into account and spread leftover space across widgets
-				const auto &min_size = child->get_min_size().get();
-				const auto &max_size = child->get_max_size().get();
-				min_width = std::max(min_width, min_size.width);
-				min_height += min_size.height;
-				max_width = std::min(max_width, max_size.width);
-				max_height += max_size.height;
-				child->position = Rect<>{
-					.top = ypos,
-					.left = 0,
-					.bottom = ypos + min_size.height,
-					.right = width,
-				};
-				ypos += min_size.height;
+	: layout_origin{[self_pointer = prop::track(this)] {
+		return Layout_extent{.width = self_pointer->position->width(), .max_width = prop::Size<>::max.width};
+	}}
+	, size_updater{[self_pointer = prop::track(this)] mutable {
+		auto &self = *self_pointer;
+		if (self.child_slots.empty()) {
+			self.min_size = prop::Size<>{0, 0};
+			self.max_size = prop::Size<>::max;
+			self.preferred_size = prop::Size<>{0, 0};
+			return;
+		}
+		const auto &extent = self.child_slots.back()->extent.get();
+		self.min_size = prop::Size{extent.min_width, extent.bottom};
+		self.max_size = prop::Size{extent.max_width, extent.max_height};
+	}}
+	, child_positioner{[self_pointer = prop::track(this), seen_version = prop::Vector_change_log::no_version] mutable {
+		auto &self = *self_pointer;
+		const auto &children_ = self.children.get();
+		const auto &change_log = self.children.get_changes();
+		auto &slots = self.child_slots;
+		//the slots of unchanged leading children stay, the children after them are positioned from scratch
+		std::size_t unchanged = 0;
+		if (const auto changes = change_log.changes_since(seen_version)) {
+			unchanged = std::min({prop::first_changed_index(*changes), std::size(slots), std::size(children_)});
+		} else {
+			while (unchanged < std::size(slots) and unchanged < std::size(children_) and
+				   slots[unchanged]->child_generation == children_[unchanged].get_generation() and
+				   slots[unchanged]->extent.is_bound()) {
+				unchanged++;
 			}
-			self.min_size = prop::Size{min_width, min_height};
-			self.max_size = prop::Size{max_width, max_height};
-		});
+		}
+		seen_version = change_log.get_version();
+		if (unchanged == std::size(slots) and unchanged == std::size(children_)) {
+			return;
+		}
+		self.remove_child_slots(unchanged);
+		for (std::size_t i = std::size(slots); i < std::size(children_); i++) {
+			auto &child = *children_[i].get();
+			auto &slot = *slots.emplace_back(std::make_unique<Child_slot>());
+			slot.child_generation = children_[i].get_generation();
+			//TODO: Don't just go with minimum size, instead take actual size into account and spread leftover space across widgets
+			slot.extent = {
+				[&child](const Layout_extent &above, const prop::Size<> &min_size, const prop::Size<> &max_size) {
+					//assigning an equal rect does not notify, so children that did not move are not touched
+					child.position = prop::Rect<>{
+						.top = above.bottom,
+						.left = 0,
+						.bottom = above.bottom + min_size.height,
+						.right = above.width,
+					};
+					return Layout_extent{
+						.width = above.width,
+						.bottom = above.bottom + min_size.height,
+						.min_width = std::max(above.min_width, min_size.width),
+						.max_width = std::min(above.max_width, max_size.width),
+						.max_height = above.max_height + max_size.height,
+					};
+				},
+				i == 0 ? self.layout_origin : slots[i - 1]->extent,
+				child.get_min_size(),
+				child.get_max_size(),
+			};
+		}
+		self.size_updater.update();
 	}}
 	, name_updater{
 		  [this](decltype(children) &children_) {
-			  std::size_t counter = 0;
-			  for (auto &child : children_.get()) {
-				  child->set_name(custom_name + ".children[" + std::to_string(counter++) + "]");
+			  const auto &change_log = children_.get_changes();
+			  const auto changes = change_log.changes_since(named_children_version);
+			  named_children_version = change_log.get_version();
+			  //names contain the index, so only children from the first changed one on need a new name
+			  const auto &children_list = children_.get();
+			  for (auto i = changes ? prop::first_changed_index(*changes) : 0; i < std::size(children_list); i++) {
+				  children_list[i]->set_name(custom_name + ".children[" + std::to_string(i) + "]");
 			  }
 		  },
 		  children,
@@ -68,7 +104,9 @@ prop::Vertical_layout::Vertical_layout(Vertical_layout &&other) noexcept {
 	swap(*this, other);
 }
 
-prop::Vertical_layout::~Vertical_layout() {}
+prop::Vertical_layout::~Vertical_layout() {
+	remove_child_slots(0);
+}
 
 prop::Vertical_layout &prop::Vertical_layout::operator=(Vertical_layout &&other) noexcept {
 	swap(*this, other);
@@ -77,7 +115,15 @@ prop::Vertical_layout &prop::Vertical_layout::operator=(Vertical_layout &&other)
 
 void prop::Vertical_layout::draw(Canvas context) const {
 	for (const auto &child : children.get()) {
-		child->draw(context.sub_canvas_for(*child.get()));
+		context.draw_widget(*child.get());
+	}
+}
+
+void prop::Vertical_layout::remove_child_slots(std::size_t remaining) {
+	//later slots depend on earlier ones, so they are destroyed first
+	while (std::size(child_slots) > remaining) {
+		auto slot = std::move(child_slots.back());
+		child_slots.pop_back();
 	}
 }
 
@@ -87,6 +133,7 @@ void prop::Vertical_layout::set_name(std::string_view name) {
 	(PROP_VERTICAL_LAYOUT_PROPERTY_MEMBERS);
 #undef PROP_X
 	prop::Widget::set_name(std::move(name));
+	named_children_version = prop::Vector_change_log::no_version;
 	name_updater.update();
 }
 
@@ -100,6 +147,8 @@ void prop::swap(Vertical_layout &lhs, Vertical_layout &rhs) {
 #define PROP_X(MEMBER) swap(lhs.MEMBER, rhs.MEMBER)
 	(PROP_VERTICAL_LAYOUT_PROPERTY_MEMBERS);
 #undef PROP_X
+	swap(lhs.child_slots, rhs.child_slots);
+	swap(lhs.named_children_version, rhs.named_children_version);
 	swap(static_cast<prop::Widget &>(lhs), static_cast<prop::Widget &>(rhs));
 }
 
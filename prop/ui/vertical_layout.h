@@ -7,6 +7,8 @@
 #include "prop/utility/property.h"
 
 #include <boost/pfr/core.hpp>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #ifdef PROPERTY_NAMES
 #include <string_view>
@@ -50,7 +52,28 @@ namespace prop {
 		template <class... Args, std::size_t... indexes>
 		static void add_children(std::vector<prop::Polywrap<prop::Widget>> &container, std::index_sequence<indexes...>,
 								 Args &&...args);
+		//running totals of the children up to and including a child, the input for positioning the next child
+		struct Layout_extent {
+			PROP_SCREEN_UNIT_PRECISION width = 0;
+			PROP_SCREEN_UNIT_PRECISION bottom = 0;
+			PROP_SCREEN_UNIT_PRECISION min_width = 0;
+			PROP_SCREEN_UNIT_PRECISION max_width = 0;
+			PROP_SCREEN_UNIT_PRECISION max_height = 0;
+			auto operator<=>(const Layout_extent &) const = default;
+		};
+		//positions one child below the previous one, so a change only affects the child and the ones below it
+		struct Child_slot {
+			//generation of the Polywrap holding the child, a new child may be allocated where a destroyed one was
+			std::uint64_t child_generation;
+			prop::Property<Layout_extent> extent;
+		};
+		void remove_child_slots(std::size_t remaining);
+		prop::Property<Layout_extent> layout_origin;
+		std::vector<std::unique_ptr<Child_slot>> child_slots;
+		prop::Property<void> size_updater;
 		prop::Property<void> child_positioner;
+		//version of children that name_updater last named the children for
+		std::uint64_t named_children_version = prop::Vector_change_log::no_version;
 		prop::Property<void> name_updater;
 	};
 } // namespace prop
@@ -2,8 +2,6 @@
 #include "prop/platform/platform.h"
 #include "prop/utility/canvas.h"
 
-#include <SFML/Graphics.hpp>
-
 //static auto get_widget_updater(prop::Window &window) {
 //	return [&window] {
 //		if (window.widget.get()) {
@@ -70,7 +68,7 @@ void prop::Window::draw(Canvas canvas) const {
 		//TODO: fill canvas?
 		return;
 	}
-	widget.get()->draw(canvas.sub_canvas_for(*widget.get()));
+	canvas.draw_widget(*widget.get());
 }
 
 prop::platform::Window &prop::Window::platform_window() const {
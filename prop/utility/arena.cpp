@@ -0,0 +1,50 @@
+#include "arena.h"
+
+#include <algorithm>
+#include <cstring>
+
+static thread_local std::pmr::memory_resource *thread_memory_resource = nullptr;
+
+prop::Arena::Arena(std::size_t initial_size)
+	: memory{std::max<std::size_t>(initial_size, 1)} {}
+
+std::pmr::memory_resource *prop::Arena::resource() {
+	return &memory;
+}
+
+prop::Arena::Scope::Scope(Arena &arena)
+	: previous_resource{std::exchange(thread_memory_resource, arena.resource())} {}
+
+prop::Arena::Scope::~Scope() {
+	thread_memory_resource = previous_resource;
+}
+
+std::pmr::memory_resource *prop::current_memory_resource() {
+	return thread_memory_resource ? thread_memory_resource : std::pmr::new_delete_resource();
+}
+
+//the resource pointer is stored right in front of the returned memory
+static std::size_t tracking_header_size(std::size_t alignment) {
+	return std::max(alignment, sizeof(std::pmr::memory_resource *));
+}
+
+void *prop::detail::allocate_tracked(std::pmr::memory_resource *resource, std::size_t size, std::size_t alignment) {
+	alignment = std::max(alignment, alignof(std::pmr::memory_resource *));
+	const auto header_size = tracking_header_size(alignment);
+	auto block = static_cast<std::byte *>(resource->allocate(header_size + size, alignment));
+	auto memory = block + header_size;
+	std::memcpy(memory - sizeof resource, &resource, sizeof resource);
+	return memory;
+}
+
+std::pmr::memory_resource *prop::detail::tracked_resource(void *p) noexcept {
+	std::pmr::memory_resource *resource;
+	std::memcpy(&resource, static_cast<std::byte *>(p) - sizeof resource, sizeof resource);
+	return resource;
+}
+
+void prop::detail::deallocate_tracked(void *p, std::size_t size, std::size_t alignment) noexcept {
+	alignment = std::max(alignment, alignof(std::pmr::memory_resource *));
+	const auto header_size = tracking_header_size(alignment);
+	tracked_resource(p)->deallocate(static_cast<std::byte *>(p) - header_size, header_size + size, alignment);
+}
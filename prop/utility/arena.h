@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+namespace prop {
+	//Memory region for a group of objects that are destroyed together, like all widgets of a screen.
+	//Link lists and bindings of properties created on a thread while an Arena::Scope is active are allocated from the
+	//arena, also when they grow later. Link lists and bindings created outside of the scope keep allocating from where
+	//they were created, even when they gain dependents or take over bindings inside of it. Destroying the arena frees
+	//all of its memory at once. Everything created in an arena must be destroyed before the arena.
+	class Arena {
+		struct Destroyer {
+			template <class T>
+			void operator()(T *t) const {
+				std::destroy_at(t);
+			}
+		};
+
+		public:
+		//owning pointer to an object in an Arena, only destroys the object because the memory belongs to the arena
+		template <class T>
+		using Pointer = std::unique_ptr<T, Destroyer>;
+
+		struct Scope {
+			Scope(Arena &arena);
+			Scope(const Scope &) = delete;
+			Scope &operator=(const Scope &) = delete;
+			~Scope();
+
+			private:
+			std::pmr::memory_resource *previous_resource;
+		};
+
+		Arena(std::size_t initial_size = 0);
+		Arena(const Arena &) = delete;
+		Arena &operator=(const Arena &) = delete;
+
+		std::pmr::memory_resource *resource();
+
+		//creates a T in this arena with everything allocated during its construction also coming from this arena
+		template <class T, class... Args>
+		Pointer<T> make(Args &&...args) {
+			Scope scope{*this};
+			auto storage = memory.allocate(sizeof(T), alignof(T));
+			try {
+				return Pointer<T>{::new (storage) T(std::forward<Args>(args)...)};
+			} catch (...) {
+				memory.deallocate(storage, sizeof(T), alignof(T));
+				throw;
+			}
+		}
+
+		private:
+		std::pmr::monotonic_buffer_resource memory;
+	};
+
+	//resource that property links and bindings created on this thread allocate from
+	std::pmr::memory_resource *current_memory_resource();
+
+	namespace detail {
+		//allocates from resource and remembers the resource so the memory can be freed later
+		void *allocate_tracked(std::pmr::memory_resource *resource, std::size_t size, std::size_t alignment);
+		std::pmr::memory_resource *tracked_resource(void *p) noexcept;
+		void deallocate_tracked(void *p, std::size_t size, std::size_t alignment) noexcept;
+	} // namespace detail
+} // namespace prop
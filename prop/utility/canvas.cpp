@@ -4,12 +4,18 @@
 #include "prop/ui/widget.h"
 #include "prop/utility/font.h"
 
-prop::Canvas::Canvas(Rect<int> rect_, platform::Canvas_context &canvas_context_)
+#include <string>
+
+prop::Canvas::Canvas(Rect<int> rect_, Rect<int> clip_, platform::Canvas_context *canvas_context_,
+					 std::vector<prop::Draw_list::Command> *recording_)
 	: rect{std::move(rect_)}
-	, canvas_context{&canvas_context_} {}
+	, clip{std::move(clip_)}
+	, canvas_context{canvas_context_}
+	, recording{recording_} {}
 
 prop::Canvas::Canvas(platform::Canvas_context &canvas_context_, int width_, int height_)
 	: rect{.bottom = height_, .right = width_}
+	, clip{rect}
 	, canvas_context{&canvas_context_} {}
 
 void prop::Canvas::draw_text(std::string_view text) {
@@ -17,21 +23,44 @@ void prop::Canvas::draw_text(std::string_view text) {
 }
 
 void prop::Canvas::draw_text(std::string_view text, Font font_) {
+	if (recording) {
+		recording->push_back(prop::Draw_list::Text{.rect = prop::Rect<>(rect), .text = std::string{text}, .font = font_});
+		return;
+	}
 	prop::platform::canvas::draw_text(*canvas_context, prop::Rect<>(rect), text, font_);
 }
 
 void prop::Canvas::draw_rect(prop::Rect<> rect_, Color color, prop::Pixels width) {
+	if (recording) {
+		recording->push_back(prop::Draw_list::Rectangle{.rect = rect_, .color = color, .width_px = width.amount});
+		return;
+	}
 	prop::platform::canvas::draw_rect(*canvas_context, rect_, color, width.amount);
 }
 
+void prop::Canvas::draw_widget(const prop::Widget &widget) {
+	if (not widget.visible.get()) {
+		return;
+	}
+	auto canvas = sub_canvas_for(widget);
+	if (prop::is_empty(canvas.clip)) {
+		return;
+	}
+	if (recording) {
+		recording->push_back(prop::Draw_list::Child{.widget = &widget, .area = canvas.rect, .clip = canvas.clip});
+		return;
+	}
+	widget.draw(canvas);
+}
+
 prop::Canvas prop::Canvas::sub_canvas_for(const prop::Widget &widget) {
 	const auto wrect = static_cast<prop::Rect<int>>(widget.position.get());
-	prop::Canvas canvas{{
-							.top = rect.top + wrect.top,
-							.left = rect.left + wrect.left,
-							.bottom = rect.top + wrect.bottom,
-							.right = rect.left + wrect.right,
-						},
-						*canvas_context};
+	const prop::Rect<int> sub_rect{
+		.top = rect.top + wrect.top,
+		.left = rect.left + wrect.left,
+		.bottom = rect.top + wrect.bottom,
+		.right = rect.left + wrect.right,
+	};
+	prop::Canvas canvas{sub_rect, prop::intersected(clip, sub_rect), canvas_context, recording};
 	return canvas;
 }
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "prop/utility/draw_list.h"
 #include "prop/utility/font.h"
 #include "prop/utility/rect.h"
 
 #include <string_view>
+#include <vector>
 
 namespace prop {
 	class Widget;
@@ -14,17 +16,25 @@ namespace prop {
 
 	class Canvas {
 		Rect<int> rect;
-		Canvas(Rect<int> rect_, prop::platform::Canvas_context &canvas_context_);
+		//part of rect that is visible, widgets outside of it are not drawn
+		Rect<int> clip;
+		Canvas(Rect<int> rect_, Rect<int> clip_, prop::platform::Canvas_context *canvas_context_,
+			   std::vector<prop::Draw_list::Command> *recording_);
 
 		public:
 		Canvas(prop::platform::Canvas_context &canvas_context_, int width_, int height_);
 		void draw_text(std::string_view text);
 		void draw_text(std::string_view text, prop::Font font_);
 		void draw_rect(prop::Rect<> rect, prop::Color color, prop::Pixels width = prop::Pixels{1});
+		//draws widget into its sub canvas, or only records that it is drawn there when recording for a Draw_list
+		//invisible widgets and widgets outside of the clip rect are skipped together with their children
+		void draw_widget(const prop::Widget &widget);
 		Canvas sub_canvas_for(const prop::Widget &widget);
 		prop::Font font;
 
 		private:
 		prop::platform::Canvas_context *canvas_context;
+		std::vector<prop::Draw_list::Command> *recording = nullptr;
+		friend class prop::Draw_list;
 	};
 } // namespace prop
@@ -0,0 +1,223 @@
+#include "draw_list.h"
+#include "prop/platform/platform.h"
+#include "prop/ui/widget.h"
+#include "prop/utility/callable.h"
+#include "prop/utility/canvas.h"
+
+#include <algorithm>
+#include <cmath>
+
+static prop::Rect<int> bounds_of(const prop::Draw_list::Command &command) {
+	return std::visit(prop::Overload{
+						  [](const prop::Draw_list::Text &text) { return static_cast<prop::Rect<int>>(text.rect); },
+						  [](const prop::Draw_list::Rectangle &rectangle) {
+							  //outlines are drawn outside of the rect
+							  const auto outline = static_cast<int>(std::ceil(std::abs(rectangle.width_px)));
+							  auto bounds = static_cast<prop::Rect<int>>(rectangle.rect);
+							  return prop::Rect<int>{
+								  .top = bounds.top - outline,
+								  .left = bounds.left - outline,
+								  .bottom = bounds.bottom + outline,
+								  .right = bounds.right + outline,
+							  };
+						  },
+						  [](const prop::Draw_list::Child &child) { return child.area; },
+					  },
+					  command);
+}
+
+//texts of the same face can be drawn together, their colors may differ
+static bool same_face(const prop::Font &lhs, const prop::Font &rhs) {
+	return lhs.name == rhs.name and lhs.size.amount == rhs.size.amount and lhs.bold == rhs.bold and
+		   lhs.italic == rhs.italic and lhs.strikeout == rhs.strikeout and lhs.underline == rhs.underline;
+}
+
+//Commands of one replay. Rects are drawn before texts and texts are drawn grouped by face, so pending commands are
+//flushed when that order would put a command below one it was drawn on top of.
+struct prop::Draw_list::Batch {
+	struct Text_group {
+		const prop::Font *font;
+		std::vector<prop::platform::canvas::Text_run> texts;
+		prop::Rect<int> bounds;
+	};
+
+	void add(const Rectangle &rectangle, prop::Rect<int> bounds) {
+		if (prop::intersects(bounds, text_bounds)) {
+			flush();
+		}
+		rects.push_back({.rect = rectangle.rect, .color = rectangle.color, .width_px = rectangle.width_px});
+	}
+
+	void add(const Text &text, prop::Rect<int> bounds) {
+		auto group = std::find_if(std::begin(text_groups), std::end(text_groups),
+								  [&text](const Text_group &text_group) { return same_face(*text_group.font, text.font); });
+		if (group != std::end(text_groups) and
+			std::any_of(std::next(group), std::end(text_groups),
+						[bounds](const Text_group &later) { return prop::intersects(later.bounds, bounds); })) {
+			flush();
+			group = std::end(text_groups);
+		}
+		if (group == std::end(text_groups)) {
+			group = text_groups.insert(group, Text_group{.font = &text.font, .texts = {}, .bounds = {}});
+		}
+		group->texts.push_back({.rect = text.rect, .text = text.text, .color = text.font.color});
+		group->bounds = prop::united(group->bounds, bounds);
+		text_bounds = prop::united(text_bounds, bounds);
+	}
+
+	void flush() {
+		if (not rects.empty()) {
+			prop::platform::canvas::draw_rects(canvas_context, rects);
+			rects.clear();
+		}
+		for (const auto &text_group : text_groups) {
+			prop::platform::canvas::draw_texts(canvas_context, text_group.texts, *text_group.font);
+		}
+		text_groups.clear();
+		text_bounds = {};
+	}
+
+	prop::platform::Canvas_context &canvas_context;
+	std::vector<prop::platform::canvas::Rect_outline> rects;
+	std::vector<Text_group> text_groups;
+	prop::Rect<int> text_bounds;
+};
+
+prop::Draw_list::Segment::Segment(const prop::Widget &widget_, prop::Rect<int> area_, prop::Rect<int> clip_)
+	: widget{const_cast<prop::Widget *>(&widget_)}
+	, area{area_}
+	, clip{clip_}
+	, recorder{[this] { Draw_list::record(*this); }} {
+	recorder.set_evaluation_mode(prop::Evaluation_mode::lazy);
+}
+
+void prop::Draw_list::record(Segment &segment) {
+	segment.commands.clear();
+	segment.bounds = {};
+	segment.recorded = true;
+	const prop::Widget *widget = segment.widget;
+	if (not widget) {
+		return;
+	}
+	prop::Canvas canvas{segment.area.get(), segment.clip.get(), nullptr, &segment.commands};
+	widget->draw(canvas);
+	for (const auto &command : segment.commands) {
+		segment.bounds = prop::united(segment.bounds, bounds_of(command));
+	}
+}
+
+prop::Draw_list::Draw_list() = default;
+prop::Draw_list::~Draw_list() = default;
+
+std::vector<prop::Rect<int>> prop::Draw_list::update(const prop::Widget &root_, prop::Rect<int> area) {
+	if (root != &root_) {
+		clear();
+		root = &root_;
+		add_dirty_region(area);
+	}
+	generation++;
+	const auto root_canvas = prop::Canvas{area, area, nullptr, nullptr}.sub_canvas_for(root_);
+	if (root_.visible.get() and not prop::is_empty(root_canvas.clip)) {
+		update_segment(root_, root_canvas.rect, root_canvas.clip);
+	}
+	std::erase_if(segments, [this](const auto &entry) {
+		if (not entry.second) {
+			return true;
+		}
+		if (entry.second->generation == generation) {
+			return false;
+		}
+		add_dirty_region(entry.second->bounds);
+		return true;
+	});
+	if (std::size(dirty_regions) > PROP_DRAW_LIST_MAX_DIRTY_REGIONS) {
+		prop::Rect<int> combined;
+		for (const auto &region : dirty_regions) {
+			combined = prop::united(combined, region);
+		}
+		dirty_regions = {combined};
+	}
+	return std::exchange(dirty_regions, {});
+}
+
+void prop::Draw_list::replay(prop::platform::Canvas_context &canvas_context, prop::Rect<int> region) const {
+	if (not root) {
+		return;
+	}
+	Batch batch{.canvas_context = canvas_context, .rects = {}, .text_groups = {}, .text_bounds = {}};
+	replay_segment(*root, batch, region);
+	batch.flush();
+}
+
+void prop::Draw_list::clear() {
+	segments.clear();
+	dirty_regions.clear();
+	root = nullptr;
+}
+
+prop::Draw_list::Segment &prop::Draw_list::segment_for(const prop::Widget &widget, prop::Rect<int> area,
+														prop::Rect<int> clip) {
+	auto &segment = segments[&widget];
+	//the widget at this address may have been replaced or moved since the segment was created
+	if (segment and static_cast<const prop::Widget *>(segment->widget) != &widget) {
+		add_dirty_region(segment->bounds);
+		segment.reset();
+	}
+	if (not segment) {
+		segment = std::make_unique<Segment>(widget, area, clip);
+		return *segment;
+	}
+	if (segment->area.get() != area) {
+		segment->area = area;
+	}
+	if (segment->clip.get() != clip) {
+		segment->clip = clip;
+	}
+	return *segment;
+}
+
+void prop::Draw_list::update_segment(const prop::Widget &widget, prop::Rect<int> area, prop::Rect<int> clip) {
+	auto &segment = segment_for(widget, area, clip);
+	const auto previous_bounds = segment.bounds;
+	segment.recorder.get();
+	if (segment.recorded) {
+		add_dirty_region(previous_bounds);
+		add_dirty_region(segment.bounds);
+		segment.recorded = false;
+	}
+	segment.generation = generation;
+	//child widgets are alive because destroying one invalidates the recording that refers to it
+	for (const auto &command : segment.commands) {
+		if (auto child = std::get_if<Child>(&command)) {
+			update_segment(*child->widget, child->area, child->clip);
+		}
+	}
+}
+
+void prop::Draw_list::replay_segment(const prop::Widget &widget, Batch &batch, prop::Rect<int> region) const {
+	auto it = segments.find(&widget);
+	if (it == std::end(segments) or not it->second) {
+		return;
+	}
+	for (const auto &command : it->second->commands) {
+		if (auto child = std::get_if<Child>(&command)) {
+			replay_segment(*child->widget, batch, region);
+			continue;
+		}
+		const auto bounds = bounds_of(command);
+		if (not prop::intersects(bounds, region)) {
+			continue;
+		}
+		if (auto text = std::get_if<Text>(&command)) {
+			batch.add(*text, bounds);
+		} else if (auto rectangle = std::get_if<Rectangle>(&command)) {
+			batch.add(*rectangle, bounds);
+		}
+	}
+}
+
+void prop::Draw_list::add_dirty_region(prop::Rect<int> region) {
+	if (not prop::is_empty(region)) {
+		dirty_regions.push_back(region);
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "prop/utility/color.h"
+#include "prop/utility/font.h"
+#include "prop/utility/property.h"
+#include "prop/utility/rect.h"
+#include "prop/utility/tracking_pointer.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#ifndef PROP_DRAW_LIST_MAX_DIRTY_REGIONS
+#define PROP_DRAW_LIST_MAX_DIRTY_REGIONS 16
+#endif
+
+namespace prop {
+	class Widget;
+	namespace platform {
+		struct Canvas_context;
+	}
+
+	//Retained record of what the widgets of a window drew.
+	//Every widget gets a segment holding the canvas calls of its Widget::draw. Recording a segment tracks the
+	//properties that draw reads, so a segment is only recorded again when one of them changed. Children are recorded
+	//into their own segments, so a change in a child does not require recording its parent again.
+	class Draw_list {
+		public:
+		struct Text {
+			prop::Rect<> rect;
+			std::string text;
+			prop::Font font;
+		};
+		struct Rectangle {
+			prop::Rect<> rect;
+			prop::Color color;
+			float width_px;
+		};
+		struct Child {
+			const prop::Widget *widget;
+			prop::Rect<int> area;
+			prop::Rect<int> clip;
+		};
+		using Command = std::variant<Text, Rectangle, Child>;
+
+		Draw_list();
+		Draw_list(const Draw_list &) = delete;
+		Draw_list &operator=(const Draw_list &) = delete;
+		~Draw_list();
+
+		//records what changed since the last call and returns the regions that need to be drawn again
+		std::vector<prop::Rect<int>> update(const prop::Widget &root, prop::Rect<int> area);
+		//draws the recorded commands that intersect region, batched into as few platform calls as the order allows
+		void replay(prop::platform::Canvas_context &canvas_context, prop::Rect<int> region) const;
+		void clear();
+
+		private:
+		struct Segment {
+			Segment(const prop::Widget &widget, prop::Rect<int> area, prop::Rect<int> clip);
+			prop::Tracking_pointer<prop::Widget> widget;
+			prop::Property<prop::Rect<int>> area;
+			prop::Property<prop::Rect<int>> clip;
+			std::vector<Command> commands;
+			//area covered by commands
+			prop::Rect<int> bounds;
+			std::size_t generation = 0;
+			bool recorded = false;
+			//keep last, recording accesses the members above
+			prop::Property<void> recorder;
+		};
+
+		struct Batch;
+		static void record(Segment &segment);
+		Segment &segment_for(const prop::Widget &widget, prop::Rect<int> area, prop::Rect<int> clip);
+		void update_segment(const prop::Widget &widget, prop::Rect<int> area, prop::Rect<int> clip);
+		void replay_segment(const prop::Widget &widget, Batch &batch, prop::Rect<int> region) const;
+		void add_dirty_region(prop::Rect<int> region);
+
+		std::unordered_map<const prop::Widget *, std::unique_ptr<Segment>> segments;
+		const prop::Widget *root = nullptr;
+		std::vector<prop::Rect<int>> dirty_regions;
+		std::size_t generation = 0;
+	};
+} // namespace prop
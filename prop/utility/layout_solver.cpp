@@ -0,0 +1,173 @@
+#include "layout_solver.h"
+#include "prop/ui/widget.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+	struct Grid_tracks {
+		std::vector<prop::Layout_constraints> items;
+		std::vector<prop::Layout_constraint> columns;
+		std::vector<prop::Layout_constraint> rows;
+	};
+} // namespace
+
+static PROP_SCREEN_UNIT_PRECISION saturating_add(PROP_SCREEN_UNIT_PRECISION lhs, PROP_SCREEN_UNIT_PRECISION rhs) {
+	return std::min(lhs + rhs, prop::Size<>::max.width);
+}
+
+static prop::Layout_constraint normalized(prop::Layout_constraint constraint) {
+	constraint.min = std::max<PROP_SCREEN_UNIT_PRECISION>(constraint.min, 0);
+	constraint.max = std::max(constraint.max, constraint.min);
+	constraint.preferred = std::clamp(constraint.preferred, constraint.min, constraint.max);
+	return constraint;
+}
+
+static prop::Layout_constraints constraints_of(const prop::Widget &widget) {
+	const auto &min = widget.get_min_size().get();
+	const auto &preferred = widget.get_preferred_size().get();
+	const auto &max = widget.get_max_size().get();
+	return {
+		.width = normalized({.min = min.width, .preferred = preferred.width, .max = max.width}),
+		.height = normalized({.min = min.height, .preferred = preferred.height, .max = max.height}),
+	};
+}
+
+static Grid_tracks grid_tracks(std::span<const prop::Polywrap<prop::Widget>> widgets, std::size_t columns) {
+	Grid_tracks tracks;
+	if (widgets.empty()) {
+		return tracks;
+	}
+	columns = std::clamp<std::size_t>(columns, 1, std::size(widgets));
+	tracks.items.reserve(std::size(widgets));
+	tracks.columns.resize(columns, {.max = 0});
+	tracks.rows.resize((std::size(widgets) + columns - 1) / columns, {.max = 0});
+	for (std::size_t i = 0; i < std::size(widgets); i++) {
+		const auto &item = tracks.items.emplace_back(constraints_of(*widgets[i].get()));
+		tracks.columns[i % columns] = prop::parallel(tracks.columns[i % columns], item.width);
+		tracks.rows[i / columns] = prop::parallel(tracks.rows[i / columns], item.height);
+	}
+	return tracks;
+}
+
+static std::vector<PROP_SCREEN_UNIT_PRECISION> offsets_of(const std::vector<PROP_SCREEN_UNIT_PRECISION> &sizes) {
+	std::vector<PROP_SCREEN_UNIT_PRECISION> offsets(std::size(sizes));
+	std::exclusive_scan(std::begin(sizes), std::end(sizes), std::begin(offsets), PROP_SCREEN_UNIT_PRECISION{0});
+	return offsets;
+}
+
+prop::Layout_constraint prop::sequential(const Layout_constraint &lhs, const Layout_constraint &rhs) {
+	return {
+		.min = saturating_add(lhs.min, rhs.min),
+		.preferred = saturating_add(lhs.preferred, rhs.preferred),
+		.max = saturating_add(lhs.max, rhs.max),
+	};
+}
+
+prop::Layout_constraint prop::parallel(const Layout_constraint &lhs, const Layout_constraint &rhs) {
+	return {
+		.min = std::max(lhs.min, rhs.min),
+		.preferred = std::max(lhs.preferred, rhs.preferred),
+		.max = std::max(lhs.max, rhs.max),
+	};
+}
+
+std::vector<PROP_SCREEN_UNIT_PRECISION> prop::solve_layout(std::span<const Layout_constraint> constraints,
+														   PROP_SCREEN_UNIT_PRECISION available) {
+	std::vector<PROP_SCREEN_UNIT_PRECISION> sizes;
+	sizes.reserve(std::size(constraints));
+	PROP_SCREEN_UNIT_PRECISION total_min = 0;
+	PROP_SCREEN_UNIT_PRECISION total_preferred = 0;
+	for (const auto &constraint : constraints) {
+		total_min += constraint.min;
+		total_preferred += constraint.preferred;
+	}
+	if (available <= total_min) {
+		for (const auto &constraint : constraints) {
+			sizes.push_back(constraint.min);
+		}
+		return sizes;
+	}
+	if (available <= total_preferred) {
+		const auto factor = (available - total_min) / (total_preferred - total_min);
+		for (const auto &constraint : constraints) {
+			sizes.push_back(constraint.min + (constraint.preferred - constraint.min) * factor);
+		}
+		return sizes;
+	}
+	//items that can grow the least take their share first, what they cannot take goes to the others
+	std::vector<std::size_t> order(std::size(constraints));
+	std::iota(std::begin(order), std::end(order), std::size_t{0});
+	std::sort(std::begin(order), std::end(order), [&constraints](std::size_t lhs, std::size_t rhs) {
+		return constraints[lhs].max - constraints[lhs].preferred < constraints[rhs].max - constraints[rhs].preferred;
+	});
+	for (const auto &constraint : constraints) {
+		sizes.push_back(constraint.preferred);
+	}
+	auto leftover = available - total_preferred;
+	for (std::size_t i = 0; i < std::size(order); i++) {
+		const auto &constraint = constraints[order[i]];
+		const auto share = leftover / static_cast<PROP_SCREEN_UNIT_PRECISION>(std::size(order) - i);
+		const auto growth = std::min(share, constraint.max - constraint.preferred);
+		sizes[order[i]] += growth;
+		leftover -= growth;
+	}
+	return sizes;
+}
+
+prop::Layout_constraints prop::grid_constraints(std::span<const prop::Polywrap<prop::Widget>> widgets,
+												std::size_t columns) {
+	if (widgets.empty()) {
+		return {};
+	}
+	const auto tracks = grid_tracks(widgets, columns);
+	prop::Layout_constraints constraints{.width = {.max = 0}, .height = {.max = 0}};
+	for (const auto &column : tracks.columns) {
+		constraints.width = prop::sequential(constraints.width, column);
+	}
+	for (const auto &row : tracks.rows) {
+		constraints.height = prop::sequential(constraints.height, row);
+	}
+	return constraints;
+}
+
+std::vector<prop::Layout_cell> prop::grid_cells(std::span<const prop::Polywrap<prop::Widget>> widgets,
+												std::size_t columns, prop::Size<> available) {
+	const auto tracks = grid_tracks(widgets, columns);
+	const auto widths = prop::solve_layout(tracks.columns, available.width);
+	const auto heights = prop::solve_layout(tracks.rows, available.height);
+	const auto lefts = offsets_of(widths);
+	const auto tops = offsets_of(heights);
+	std::vector<prop::Layout_cell> cells;
+	cells.reserve(std::size(widgets));
+	for (std::size_t i = 0; i < std::size(widgets); i++) {
+		const auto column = i % std::size(tracks.columns);
+		const auto row = i / std::size(tracks.columns);
+		const auto &item = tracks.items[i];
+		//widgets fill their cell as far as their limits allow
+		const auto width = std::clamp(widths[column], item.width.min, item.width.max);
+		const auto height = std::clamp(heights[row], item.height.min, item.height.max);
+		cells.push_back({
+			.widget = widgets[i].get(),
+			.rect = {.top = tops[row], .left = lefts[column], .bottom = tops[row] + height, .right = lefts[column] + width},
+		});
+	}
+	return cells;
+}
+
+void prop::bind_to_cell(prop::Widget &widget, std::size_t index,
+						const prop::Property<std::vector<Layout_cell>> &cells) {
+	widget.position = {
+		[&widget, index](prop::Rect<> &position, const std::vector<Layout_cell> &cells_) {
+			if (index >= std::size(cells_) or cells_[index].widget != &widget) {
+				return prop::Updater_result::unbind;
+			}
+			if (position == cells_[index].rect) {
+				return prop::Updater_result::unchanged;
+			}
+			position = cells_[index].rect;
+			return prop::Updater_result::changed;
+		},
+		cells,
+	};
+}
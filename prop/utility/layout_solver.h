@@ -0,0 +1,53 @@
+#pragma once
+
+#include "prop/utility/polywrap.h"
+#include "prop/utility/property.h"
+#include "prop/utility/rect.h"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace prop {
+	class Widget;
+
+	//size limits of an item along one axis
+	struct Layout_constraint {
+		PROP_SCREEN_UNIT_PRECISION min = 0;
+		PROP_SCREEN_UNIT_PRECISION preferred = 0;
+		PROP_SCREEN_UNIT_PRECISION max = prop::Size<>::max.width;
+		auto operator<=>(const Layout_constraint &) const = default;
+	};
+
+	struct Layout_constraints {
+		Layout_constraint width;
+		Layout_constraint height;
+		auto operator<=>(const Layout_constraints &) const = default;
+	};
+
+	//where a layout places a widget, relative to the layout
+	struct Layout_cell {
+		const prop::Widget *widget;
+		prop::Rect<> rect;
+		auto operator<=>(const Layout_cell &) const = default;
+	};
+
+	//limits of items placed one after another
+	Layout_constraint sequential(const Layout_constraint &lhs, const Layout_constraint &rhs);
+	//limits of items placed side by side in the same space, like the cells of a column
+	Layout_constraint parallel(const Layout_constraint &lhs, const Layout_constraint &rhs);
+
+	//Sizes of items sharing available space in one pass. Items get their min size first, then grow towards their
+	//preferred size proportionally, then share what is left equally without growing past their max size.
+	std::vector<PROP_SCREEN_UNIT_PRECISION> solve_layout(std::span<const Layout_constraint> constraints,
+														 PROP_SCREEN_UNIT_PRECISION available);
+
+	//Widgets are placed in rows of columns cells, row by row. A column is as wide as the widest min, preferred and max
+	//width of its widgets, a row as high as its highest ones.
+	Layout_constraints grid_constraints(std::span<const prop::Polywrap<prop::Widget>> widgets, std::size_t columns);
+	std::vector<Layout_cell> grid_cells(std::span<const prop::Polywrap<prop::Widget>> widgets, std::size_t columns,
+										prop::Size<> available);
+
+	//binds the position of the widget at index to its cell, it unbinds itself once the cell belongs to another widget
+	void bind_to_cell(prop::Widget &widget, std::size_t index, const prop::Property<std::vector<Layout_cell>> &cells);
+} // namespace prop
@@ -12,12 +12,19 @@ Purpose 2:
 	If you pass an std::unique_ptr with a custom deleter, that custom deleter will be called appropriately.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "exceptions.h"
+#include "property_decls.h"
 #include "type_name.h"
 #include "type_traits.h"
 
@@ -46,6 +53,8 @@ namespace prop {
 			});
 		template <class Settee_type, class Setter_type>
 		concept Settable = requires(Settee_type &&s) { std::declval<Setter_type>().set(std::forward<Settee_type>(s)); };
+
+		inline std::atomic<std::uint64_t> last_polywrap_generation;
 	} // namespace detail
 
 	template <class T>
@@ -66,6 +75,8 @@ namespace prop {
 		operator T *() const;
 		explicit operator bool() const;
 		T *operator->() const;
+		//changes whenever the Polywrap starts holding another object and is never reused, unlike the object's address
+		std::uint64_t get_generation() const;
 
 		void set(prop::detail::Compatible_polywrap_value<T> auto &&v);
 		void set(prop::detail::Compatible_polywrap_pointer<T> auto &&p);
@@ -73,7 +84,9 @@ namespace prop {
 		void set(std::nullptr_t);
 
 		private:
+		void new_generation();
 		std::shared_ptr<T> value_ptr;
+		std::uint64_t generation = 0;
 	};
 
 	namespace detail {
@@ -177,6 +190,25 @@ namespace prop {
 	PROP_BINOPS
 #undef PROP_X
 #undef PROP_BINOPS
+
+	//Only which objects are held and in what order matters, changes of the objects themselves are changes of their own
+	//properties. This lets properties of Polywrap vectors ignore writes that keep the same objects. Generations are used
+	//instead of addresses because a new object may be allocated where a destroyed one was.
+	template <class T>
+	struct Change_key<std::vector<prop::Polywrap<T>>> {
+		std::vector<std::uint64_t> operator()(const std::vector<prop::Polywrap<T>> &polywraps) const {
+			std::vector<std::uint64_t> generations;
+			generations.reserve(std::size(polywraps));
+			for (const auto &polywrap : polywraps) {
+				generations.push_back(polywrap.get_generation());
+			}
+			return generations;
+		}
+		static bool equal(const std::vector<prop::Polywrap<T>> &lhs, const std::vector<prop::Polywrap<T>> &rhs) {
+			constexpr auto generation = &prop::Polywrap<T>::get_generation;
+			return std::ranges::equal(lhs, rhs, {}, generation, generation);
+		}
+	};
 } // namespace prop
 
 //implementation
@@ -224,6 +256,16 @@ namespace prop {
 		return value_ptr.get();
 	}
 
+	template <class T>
+	std::uint64_t Polywrap<T>::get_generation() const {
+		return generation;
+	}
+
+	template <class T>
+	void Polywrap<T>::new_generation() {
+		generation = value_ptr ? ++prop::detail::last_polywrap_generation : 0;
+	}
+
 	template <class T>
 	Polywrap<T>::operator bool() const {
 		return value_ptr != nullptr;
@@ -257,6 +299,7 @@ namespace prop {
 			std::make_unique<prop::detail::T_holder<T, U>>(std::forward<decltype(v)>(v))};
 		T *tp = deleter.holder->ptr;
 		value_ptr = std::shared_ptr<T>(tp, std::move(deleter));
+		new_generation();
 	}
 
 	template <class T>
@@ -268,12 +311,14 @@ namespace prop {
 			T *ptr = &*p;
 			value_ptr = std::shared_ptr<T>(ptr, prop::detail::T_adopter<T, U>{std::forward<decltype(p)>(p)});
 		}
+		new_generation();
 	}
 
 	template <class T>
 	void Polywrap<T>::set(prop::detail::Compatible_polywrap<T> auto &&v) {
 		if constexpr (std::is_rvalue_reference_v<decltype(v)>) {
 			std::swap(value_ptr, v.value_ptr);
+			std::swap(generation, v.generation);
 			return;
 		} else if constexpr (!std::is_polymorphic_v<T>) {
 			set(*v.value_ptr);
@@ -285,6 +330,7 @@ namespace prop {
 				prop::detail::T_deleter<T> deleter{std::unique_ptr<prop::detail::T_holder_base<T>>(holder)};
 				T *ptr = deleter.holder->ptr;
 				value_ptr = std::shared_ptr<T>(ptr, std::move(deleter));
+				new_generation();
 				if (dynamic_cast<prop::detail::T_holder<T, U> *>(deleter_ptr->holder.get())) {
 					*value_ptr = *v.value_ptr;
 					return;
@@ -298,6 +344,7 @@ namespace prop {
 	template <class T>
 	void Polywrap<T>::set(std::nullptr_t) {
 		value_ptr = nullptr;
+		generation = 0;
 	}
 
 	template <class T>
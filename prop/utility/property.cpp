@@ -31,8 +31,7 @@ void prop::Property<void>::unbind() {
 	Property_link::unbind();
 }
 
-void prop::Property<void>::update_source(
-	std::move_only_function<prop::Updater_result(std::span<const prop::Property_link::Property_pointer>)> f) {
+void prop::Property<void>::update_source(detail::binding_function_t<void> f) {
 	std::swap(f, source);
 	update();
 }
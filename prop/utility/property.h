@@ -3,9 +3,14 @@
 #include "property_details.h"
 #include "raii.h"
 #include "utility.h"
+#include "vector_change.h"
 #include <algorithm>
+#include <cassert>
 #include <format>
 #include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace prop {
 	using detail::converts_to;
@@ -127,6 +132,18 @@ namespace prop {
 		template <class T>
 		Printer(const T &) -> Printer<T>;
 
+		struct No_change_log {};
+		struct No_change_key {};
+
+		template <class T>
+		auto change_key_of(const T &value) {
+			if constexpr (has_change_key<T>) {
+				return prop::Change_key<T>{}(value);
+			} else {
+				return No_change_key{};
+			}
+		}
+
 		template <class T>
 		std::ostream &operator<<(std::ostream &os, prop::detail::Printer<T> &&printer) {
 			return printer.print(os);
@@ -135,8 +152,11 @@ namespace prop {
 
 	template <class T>
 	class Property : public prop::Property_link {
+		static constexpr bool is_vector = prop::is_template_specialization_v<T, std::vector>;
 		mutable T value{};
 		detail::binding_function_t<T> source;
+		//structural changes of vectors, so dependents can look at just the elements that changed
+		[[no_unique_address]] std::conditional_t<is_vector, prop::Vector_change_log, detail::No_change_log> change_log;
 		struct Write_notifier;
 
 		public:
@@ -184,6 +204,9 @@ namespace prop {
 				unbind();
 				value = t;
 				write_notify();
+			} else if (is_stale()) {
+				//assigning an equal value does nothing, except that a stale binding must not overwrite it on the next read
+				unbind();
 			}
 			return *this;
 		}
@@ -194,20 +217,26 @@ namespace prop {
 				unbind();
 				value = std::move(t);
 				write_notify();
+			} else if (is_stale()) {
+				unbind();
 			}
 			return *this;
 		}
 		Property<T> &operator=(Property<T> &&other) {
 			value = std::move(other.value);
 			source = std::move(other.source);
+			change_log = std::exchange(other.change_log, {});
 			Property_link::operator=(static_cast<prop::Property_link &&>(other));
 			return *this;
 		}
 		Property<T> &operator=(const Property<T> &other) {
-			if (not detail::is_equal(other.value, value)) {
+			const auto &other_value = other.get();
+			if (not detail::is_equal(other_value, value)) {
 				unbind();
-				value = other.value;
+				value = other_value;
 				write_notify();
+			} else if (is_stale()) {
+				unbind();
 			}
 			return *this;
 		}
@@ -232,6 +261,25 @@ namespace prop {
 		template <class Functor>
 		std::invoke_result_t<Functor, T &> apply(Functor &&f);
 
+		//Structural changes of vectors. Like apply they notify all dependents, but dependents can use get_changes to
+		//find out which elements changed instead of looking at all of them. Other writes change all elements.
+		template <class... Args>
+		void emplace(std::size_t index, Args &&...args)
+			requires is_vector;
+		template <class... Args>
+		void emplace_back(Args &&...args)
+			requires is_vector;
+		void erase(std::size_t index, std::size_t count = 1)
+			requires is_vector;
+		//moves the element at from so that it ends up at index to
+		void move(std::size_t from, std::size_t to)
+			requires is_vector;
+		template <class Functor>
+		void apply_at(std::size_t index, Functor &&f)
+			requires is_vector;
+		const prop::Vector_change_log &get_changes() const
+			requires is_vector;
+
 		template <class U>
 		bool is_implicit_dependency_of(const Property<U> &other) const;
 		template <class U>
@@ -421,6 +469,11 @@ namespace prop {
 				}
 			}
 			~Write_notifier() {
+				if constexpr (detail::has_change_key<T>) {
+					if (p and detail::change_key_of(p->value) == key_before) {
+						return;
+					}
+				}
 				if (p) {
 					p->write_notify();
 				}
@@ -428,12 +481,17 @@ namespace prop {
 
 			private:
 			Write_notifier(prop::Property<T> *p_)
-				: p{p_} {}
+				: p{p_}
+				, key_before{detail::change_key_of(p_->value)} {}
 			friend class prop::Property<T>;
 			prop::Property<T> *p;
+			//the value may be changed in any way, so only a snapshot of the key tells whether it changed
+			[[no_unique_address]] decltype(detail::change_key_of(std::declval<const T &>())) key_before;
 		};
 		void update_source(detail::binding_function_t<T> f);
 		void update() override final;
+		void write_notify();
+		void structural_write_notify(const prop::Vector_change &change);
 		friend class Binding;
 
 		template <class U>
@@ -609,8 +667,7 @@ namespace prop {
 		Property_link(prop::type_name<prop::Property<T>>())
 		,
 #endif
-		value{other.value} {
-		other.read_notify();
+		value{other.get()} {
 	}
 	template <class T>
 	Property<T>::Property(Property<T> &&other)
@@ -620,7 +677,8 @@ namespace prop {
 		,
 #endif
 		value{std::move(other.value)}
-		, source{std::move(other.source)} {
+		, source{std::move(other.source)}
+		, change_log{std::exchange(other.change_log, {})} {
 		Property_link::operator=(static_cast<prop::Property_link &&>(other));
 	}
 
@@ -785,6 +843,8 @@ namespace prop {
 
 	template <class T>
 	Property<T>::Write_notifier Property<T>::apply() {
+		//changes must be made to the current value, not to the one a stale binding is about to replace
+		read_notify();
 		return {this};
 	}
 
@@ -812,6 +872,93 @@ namespace prop {
 		}
 	}
 
+	template <class T>
+	template <class... Args>
+	void Property<T>::emplace(std::size_t index, Args &&...args)
+		requires is_vector
+	{
+		//like apply, a stale value is brought up to date before it is changed
+		read_notify();
+		assert(index <= std::size(value));
+		value.emplace(std::begin(value) + static_cast<std::ptrdiff_t>(index), std::forward<Args>(args)...);
+		structural_write_notify({.type = prop::Vector_change::Type::insert, .index = index});
+	}
+
+	template <class T>
+	template <class... Args>
+	void Property<T>::emplace_back(Args &&...args)
+		requires is_vector
+	{
+		read_notify();
+		emplace(std::size(value), std::forward<Args>(args)...);
+	}
+
+	template <class T>
+	void Property<T>::erase(std::size_t index, std::size_t count)
+		requires is_vector
+	{
+		read_notify();
+		count = std::min(count, std::size(value) - std::min(index, std::size(value)));
+		if (count == 0) {
+			return;
+		}
+		const auto first = std::begin(value) + static_cast<std::ptrdiff_t>(index);
+		value.erase(first, first + static_cast<std::ptrdiff_t>(count));
+		structural_write_notify({.type = prop::Vector_change::Type::erase, .index = index, .count = count});
+	}
+
+	template <class T>
+	void Property<T>::move(std::size_t from, std::size_t to)
+		requires is_vector
+	{
+		read_notify();
+		assert(from < std::size(value) and to < std::size(value));
+		if (from == to) {
+			return;
+		}
+		const auto element = std::begin(value) + static_cast<std::ptrdiff_t>(from);
+		const auto destination = std::begin(value) + static_cast<std::ptrdiff_t>(to);
+		if (from < to) {
+			std::rotate(element, element + 1, destination + 1);
+		} else {
+			std::rotate(destination, element, element + 1);
+		}
+		structural_write_notify({.type = prop::Vector_change::Type::move, .index = from, .to = to});
+	}
+
+	template <class T>
+	template <class Functor>
+	void Property<T>::apply_at(std::size_t index, Functor &&f)
+		requires is_vector
+	{
+		read_notify();
+		assert(index < std::size(value));
+		std::forward<Functor>(f)(value[index]);
+		structural_write_notify({.type = prop::Vector_change::Type::update, .index = index});
+	}
+
+	template <class T>
+	const prop::Vector_change_log &Property<T>::get_changes() const
+		requires is_vector
+	{
+		read_notify();
+		return change_log;
+	}
+
+	template <class T>
+	void Property<T>::write_notify() {
+		if constexpr (is_vector) {
+			change_log.reset();
+		}
+		prop::Property_link::write_notify();
+	}
+
+	template <class T>
+	void Property<T>::structural_write_notify(const prop::Vector_change &change) {
+		change_log.record(change);
+		prop::Property_link::write_notify();
+	}
+
 	template <class T>
 	template <class U>
 	bool Property<T>::is_implicit_dependency_of(const Property<U> &other) const {
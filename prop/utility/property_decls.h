@@ -1,28 +1,50 @@
 #pragma once
 
 #include "prop/utility/required_pointer.h"
+#include "prop/utility/small_function.h"
 
+#include <concepts>
+#include <cstddef>
 #include <functional>
 #include <span>
 #include <type_traits>
 
+#ifndef PROP_BINDING_BUFFER_SIZE
+//size of the bindings that can be stored in a Property without allocating
+#define PROP_BINDING_BUFFER_SIZE 48
+#endif
+
 namespace prop {
 	template <class T>
 	class Property;
 
 	enum struct Updater_result : char { unchanged, changed, unbind };
 
+	//Specialize with a const operator() returning an equality comparable key for types without a meaningful operator==.
+	//Writes to a Property<T> that leave the key unchanged are not treated as changes, so dependents are not updated.
+	//Equal keys must mean equal values, a hash that can collide would drop real changes. A static equal(lhs, rhs) is
+	//used instead of building two keys when a value is assigned, the key itself is only built to check apply().
+	template <class T>
+	struct Change_key {};
+
 	class Property_link;
 	namespace detail {
 		template <class T>
-		std::move_only_function<prop::Updater_result(prop::Property<T> &,
-													 std::span<const prop::Required_pointer<Property_link>>)>
+		prop::Small_function<prop::Updater_result(prop::Property<T> &,
+												  std::span<const prop::Required_pointer<Property_link>>),
+							 PROP_BINDING_BUFFER_SIZE>
 		get_binding_function(T *);
-		std::move_only_function<prop::Updater_result(std::span<const prop::Required_pointer<Property_link>>)>
+		prop::Small_function<prop::Updater_result(std::span<const prop::Required_pointer<Property_link>>),
+							 PROP_BINDING_BUFFER_SIZE>
 		get_binding_function(void *);
 		template <class T>
 		using binding_function_t = decltype(get_binding_function(std::declval<T *>()));
 
+		template <class T>
+		concept has_change_key = requires(const T &t) {
+			{ prop::Change_key<T>{}(t) } -> std::equality_comparable;
+		};
+
 		template <class T, class Function, class... Properties, std::size_t... indexes>
 			requires(not std::is_same_v<T, void>)
 		detail::binding_function_t<T> create_explicit_caller(Function &&function, std::index_sequence<indexes...>);
@@ -19,25 +19,44 @@
 namespace prop {
 	namespace detail {
 		template <class T>
-		std::move_only_function<prop::Updater_result(prop::Property<T> &,
-													 std::span<const prop::Property_link::Property_pointer>)>
+		prop::Small_function<prop::Updater_result(prop::Property<T> &,
+												  std::span<const prop::Property_link::Property_pointer>),
+							 PROP_BINDING_BUFFER_SIZE>
 		get_binding_function(T *);
-		std::move_only_function<prop::Updater_result(std::span<const prop::Property_link::Property_pointer>)>
+		prop::Small_function<prop::Updater_result(std::span<const prop::Property_link::Property_pointer>),
+							 PROP_BINDING_BUFFER_SIZE>
 		get_binding_function(void *);
 		template <class T>
 		using binding_function_t = decltype(get_binding_function(std::declval<T *>()));
 
-		template <class T, class U = T>
-		concept is_equal_comparable_v = requires(const T &t, const U &u) {
+		template <class T, class U>
+		concept has_operator_equal = requires(const T &t, const U &u) {
 			//TODO: handle containers and tuple-likes
 			{ t == u } -> std::convertible_to<bool>;
 		};
 
+		//types without operator== can be compared through their prop::Change_key
+		template <class T, class U = T>
+		concept is_equal_comparable_v =
+			has_operator_equal<T, U> or (std::is_same_v<std::remove_cvref_t<T>, std::remove_cvref_t<U>> and
+										 prop::detail::has_change_key<std::remove_cvref_t<T>>);
+
+		template <class T>
+		bool change_keys_equal(const T &lhs, const T &rhs) {
+			if constexpr (requires { prop::Change_key<T>::equal(lhs, rhs); }) {
+				return prop::Change_key<T>::equal(lhs, rhs);
+			} else {
+				return prop::Change_key<T>{}(lhs) == prop::Change_key<T>{}(rhs);
+			}
+		}
+
 		template <class T, class U>
 		constexpr bool is_equal(const T &lhs, const U &rhs) {
 			//TODO: handle containers and tuple-likes
-			if constexpr (is_equal_comparable_v<T, U>) {
+			if constexpr (has_operator_equal<T, U>) {
 				return lhs == rhs;
+			} else if constexpr (is_equal_comparable_v<T, U>) {
+				return change_keys_equal(lhs, rhs);
 			}
 			return false;
 		}
@@ -440,9 +459,7 @@ namespace prop {
 				: Property_function_binder(std::forward<Function>(function_),
 										   typename prop::Callable_info_for<Function>::Params{}, properties...) {}
 
-			std::move_only_function<prop::Updater_result(prop::Property<T> &,
-														 std::span<const Property_link::Property_pointer>)>
-				function;
+			detail::binding_function_t<T> function;
 			std::vector<prop::Property_link::Property_pointer> dependencies;
 
 			private:
@@ -476,7 +493,7 @@ namespace prop {
 				: Property_function_binder(std::forward<Function>(function_),
 										   typename prop::Callable_info_for<Function>::Params{}, properties...) {}
 
-			std::move_only_function<prop::Updater_result(std::span<const Property_link::Property_pointer>)> function;
+			detail::binding_function_t<void> function;
 			std::vector<prop::Property_link::Property_pointer> dependencies;
 
 			private:
@@ -507,8 +524,7 @@ namespace prop {
 		}
 
 		template <class T>
-		std::move_only_function<prop::Updater_result(prop::Property<T> &, std::span<const Property_link>)>
-		make_direct_update_function(Property_update_function<T> auto &&f) {
+		detail::binding_function_t<T> make_direct_update_function(Property_update_function<T> auto &&f) {
 			return [source = std::forward<decltype(f)>(f)](prop::Property<T> &t,
 														   std::span<const Property_link::Property_pointer>) mutable {
 				if constexpr (prop::detail::is_equal_comparable_v<std::decay_t<decltype(source())>, T>) {
@@ -526,9 +542,8 @@ namespace prop {
 		}
 
 		template <class T, std::size_t... indexes>
-		std::move_only_function<prop::Updater_result(prop::Property<T> &,
-													 std::span<const Property_link::Property_pointer>)>
-		make_direct_update_function(Updater_function<T> auto &&f, std::index_sequence<indexes...>) {
+		detail::binding_function_t<T> make_direct_update_function(Updater_function<T> auto &&f,
+																   std::index_sequence<indexes...>) {
 			return [source = std::forward<decltype(f)>(f)](
 					   prop::Property<T> &p,
 					   [[maybe_unused]] std::span<const Property_link::Property_pointer> links) mutable {
@@ -542,9 +557,7 @@ namespace prop {
 		}
 
 		template <class T>
-		std::move_only_function<prop::Updater_result(prop::Property<T> &,
-													 std::span<const Property_link::Property_pointer>)>
-		make_direct_update_function(Updater_function<T> auto &&f) {
+		detail::binding_function_t<T> make_direct_update_function(Updater_function<T> auto &&f) {
 			return make_direct_update_function<T>(
 				std::forward<decltype(f)>(f),
 				std::make_index_sequence<prop::Callable_info_for<decltype(f)>::Params::size - 1>());
@@ -1,9 +1,16 @@
 #include "property_link.h"
 #include "color.h"
-#include "tracking_list.h"
+#include "raii.h"
 #include "type_name.h"
 #include "utility.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <thread>
+
 #ifdef PROP_LIFETIMES
 std::map<const prop::Property_link *, prop::Property_link::Property_link_lifetime_status> &
 prop::Property_link::lifetimes() {
@@ -151,34 +158,114 @@ struct Tracer {
 
 void prop::Property_link::read_notify() const {
 	assert_status();
+	refresh_if_stale();
 	binding_data.read_notify(this);
 }
 
 void prop::Property_link::write_notify() {
 	assert_status();
+	version = next_version();
+	stale = false;
+	if (refreshing) {
+		//dependents have already been notified when this property became stale
+		return;
+	}
+	notify_dependents(true);
+}
+
+void prop::Property_link::notify_dependents(bool written) {
 	if (explicit_dependencies + implicit_dependencies == dependencies.size()) {
 		return;
 	}
 	TRACE("Notifying  " << to_string() << "->" << get_dependents());
-	switch (dependencies.size() - explicit_dependencies - implicit_dependencies) {
-		case 0:
+	propagation.schedule_dependents_of(this, written);
+	if (not propagation.is_running() and not propagation.is_batching()) {
+		propagation.run();
+	}
+}
+
+void prop::Property_link::invalidate() {
+	if (evaluation_mode == Evaluation_mode::eager) {
+		if (not take_input_written() and inputs_unchanged()) {
+			TRACE("Skipping   " << to_string() << " because its dependencies did not change");
 			return;
-		case 1:
-			dependencies.back()->Property_link::update();
-			break;
-		default:
-			for (auto &dependent : prop::Tracking_list<>::of_dependents(*this)) {
-				dependent->Property_link::update();
-			}
-			break;
+		}
+		Property_link::update();
+		return;
+	}
+	TRACE("Staling    " << to_string());
+	{
+		auto lock = Propagation_list::lock_links();
+		stale = true;
+	}
+	notify_dependents(false);
+}
+
+void prop::Property_link::refresh() const {
+	TRACE("Refreshing " << to_string());
+	auto lock = Propagation_list::lock_links();
+	//stale is cleared after the update so other threads never see the value before it is complete
+	refreshing = true;
+	prop::detail::RAII reset{[this] {
+		refreshing = false;
+		stale = false;
+	}};
+	if (not take_input_written() and inputs_unchanged()) {
+		TRACE("Skipping   " << to_string() << " because its dependencies did not change");
+		return;
+	}
+	const_cast<Property_link *>(this)->Property_link::update();
+}
+
+bool prop::Property_link::take_input_written() const {
+	auto lock = Propagation_list::lock_links();
+	return std::exchange(input_written, false);
+}
+
+void prop::Property_link::refresh_if_stale() const {
+	if (not stale) {
+		return;
+	}
+	auto lock = Propagation_list::lock_links();
+	if (stale and not refreshing) {
+		refresh();
+	}
+}
+
+void prop::Property_link::set_evaluation_mode(Evaluation_mode mode) {
+	assert_status();
+	evaluation_mode = mode;
+	if (mode == Evaluation_mode::eager and stale) {
+		refresh();
 	}
 }
 
 const prop::Update_data prop::Property_link::update_start() {
 	assert_status();
+	//dependencies written after this point get a higher version
+	inputs_version = last_version.load(std::memory_order_relaxed);
 	return binding_data.update_start(this);
 }
 
+bool prop::Property_link::inputs_unchanged() const {
+	if (inputs_version == 0) {
+		return false;
+	}
+	for (std::size_t i = 0; i < 0u + explicit_dependencies + implicit_dependencies; i++) {
+		const auto dependency = dependencies[i].get_pointer();
+		if (not dependency) {
+			//an explicit dependency was destroyed
+			return false;
+		}
+		//a stale dependency may end up with its old value, which would not require an update either
+		dependency->refresh_if_stale();
+		if (dependency->version > inputs_version) {
+			return false;
+		}
+	}
+	return true;
+}
+
 void prop::Property_link::update_complete(const prop::Update_data &update_data) {
 	binding_data.update_end(update_data);
 }
@@ -216,9 +303,10 @@ prop::Property_link::Property_link([[maybe_unused]] std::string_view type) {
 }
 
 prop::Property_link::Property_link(std::vector<prop::Property_link::Property_pointer> initial_explicit_dependencies)
-	: dependencies{std::move(initial_explicit_dependencies)}
+	: dependencies(std::begin(initial_explicit_dependencies), std::end(initial_explicit_dependencies))
 	, explicit_dependencies{static_cast<decltype(explicit_dependencies)>(dependencies.size())} {
 	set_status();
+	auto lock = Propagation_list::lock_links();
 	for (auto &explicit_dependency : dependencies) {
 		if (auto ptr = explicit_dependency.get_pointer()) {
 			ptr->add_dependent(*this);
@@ -240,10 +328,18 @@ prop::Property_link::Property_link(Property_link &&other) {
 	custom_name = std::move(other.custom_name);
 	other.custom_name = "<moved from>";
 #endif
+	auto lock = Propagation_list::lock_links();
 	using std::swap;
 	swap(explicit_dependencies, other.explicit_dependencies);
 	swap(implicit_dependencies, other.implicit_dependencies);
 	swap(dependencies, other.dependencies);
+	swap(dependent_index, other.dependent_index);
+	swap(propagation_index, other.propagation_index);
+	swap(evaluation_mode, other.evaluation_mode);
+	stale = other.stale.exchange(stale);
+	swap(inputs_version, other.inputs_version);
+	other.version = next_version();
+	propagation.relocate(this);
 
 	for (std::size_t i = 0; i < explicit_dependencies + implicit_dependencies; ++i) { //dependencies
 		if (auto dependency_ptr = dependencies[i].get_pointer()) {
@@ -267,9 +363,14 @@ prop::Property_link::Property_link(Property_link &&other) {
 	}
 }
 
+std::uint64_t prop::Property_link::next_version() {
+	return last_version.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 void prop::Property_link::unbind() {
 	assert_status();
 	TRACE("Unbinding  " << get_status());
+	auto lock = Propagation_list::lock_links();
 	for (std::size_t i = 0; i < explicit_dependencies + implicit_dependencies; i++) {
 		if (dependencies[i]) {
 			TRACE("Removing   " << dependencies[i]->to_string() << " from dependencies of " << to_string());
@@ -279,6 +380,8 @@ void prop::Property_link::unbind() {
 	dependencies.erase(std::begin(dependencies),
 					   std::begin(dependencies) + explicit_dependencies + implicit_dependencies);
 	explicit_dependencies = implicit_dependencies = 0;
+	inputs_version = 0;
+	stale = false;
 }
 
 void prop::Property_link::operator=(Property_link &&other) {
@@ -291,7 +394,9 @@ void prop::Property_link::operator=(Property_link &&other) {
 prop::Property_link::~Property_link() {
 	assert_status();
 	TRACE("Destroying " << get_status());
+	auto lock = Propagation_list::lock_links();
 	binding_data.remove(this);
+	propagation.remove(this);
 	for (std::size_t dependency_index = 0; dependency_index < explicit_dependencies + implicit_dependencies;
 		 dependency_index++) {
 		auto &dependency = dependencies[dependency_index];
@@ -335,7 +440,8 @@ prop::Property_link::~Property_link() {
 			}
 		}
 		if (update_needed and &dependent != binding_data.current_binding()) {
-			dependent.update();
+			dependent.inputs_version = 0;
+			dependent.invalidate();
 		}
 	}
 	TRACE("Destroyed  " << to_string());
@@ -350,19 +456,29 @@ void prop::swap(Property_link &lhs, Property_link &rhs) {
 	lhs.assert_status();
 	rhs.assert_status();
 	TRACE("Swapping   " << lhs.to_string() << " and " << rhs.to_string());
+	auto lock = Propagation_list::lock_links();
+	std::swap(lhs.propagation_index, rhs.propagation_index);
+	std::swap(lhs.evaluation_mode, rhs.evaluation_mode);
+	lhs.stale = rhs.stale.exchange(lhs.stale);
+	lhs.version = Property_link::next_version();
+	rhs.version = Property_link::next_version();
+	lhs.inputs_version = rhs.inputs_version = 0;
+	prop::Property_link::propagation.relocate(&lhs);
+	prop::Property_link::propagation.relocate(&rhs);
 	if (lhs.dependencies.empty() and rhs.dependencies.empty()) {
 		return;
 	}
 	struct Tmp final : Property_link {
 		Tmp()
 			: Property_link(prop::type_name<Tmp>()) {}
-	} static sentinel;
+	} static thread_local sentinel;
 
 	auto replace = [](Property_link &pb_old, Property_link &pb_new) {
 		std::swap(pb_old.custom_name, pb_new.custom_name);
 		assert(pb_new.dependencies.empty());
 		assert(pb_new.explicit_dependencies == 0);
 		assert(pb_new.implicit_dependencies == 0);
+		assert(not pb_new.dependent_index);
 		assert(pb_old.explicit_dependencies + pb_old.implicit_dependencies <= pb_old.dependencies.size());
 		if (pb_old.dependencies.empty()) {
 			return;
@@ -384,6 +500,7 @@ void prop::swap(Property_link &lhs, Property_link &rhs) {
 			}
 			pb_new.dependencies.push_back(dependent_link);
 		}
+		pb_new.dependent_index = std::move(pb_old.dependent_index);
 		pb_old.explicit_dependencies = pb_old.implicit_dependencies = 0;
 		pb_old.dependencies.clear();
 	};
@@ -407,13 +524,11 @@ bool prop::Property_link::has_source() const {
 void prop::Property_link::set_explicit_dependencies(std::vector<Property_link::Property_pointer> &&deps) {
 	assert_status();
 	assert(deps.size() < std::numeric_limits<decltype(explicit_dependencies)>::max());
+	auto lock = Propagation_list::lock_links();
+	inputs_version = 0;
 	if (dependencies.empty()) {
 		TRACE("Setting    " << to_string() << "'s explicit dependencies to\n           " << deps);
-		if (dependencies.capacity() > deps.capacity()) {
-			std::copy(std::begin(deps), std::end(deps), std::back_inserter(dependencies));
-		} else {
-			dependencies = std::move(deps);
-		}
+		dependencies.assign(std::begin(deps), std::end(deps));
 		for (const auto &dependency : dependencies) {
 			dependency->add_dependent(*this);
 		}
@@ -441,19 +556,48 @@ void prop::Property_link::set_explicit_dependencies(std::vector<Property_link::P
 		dependencies[i]->add_dependent(*this);
 	}
 	while (explicit_dependencies < deps.size()) {
-		dependencies.insert(std::begin(deps) + explicit_dependencies, deps[explicit_dependencies]);
+		dependencies.insert(std::begin(dependencies) + explicit_dependencies, deps[explicit_dependencies]);
 		dependencies[explicit_dependencies++]->add_dependent(*this);
 	}
 	if (explicit_dependencies > deps.size()) {
 		for (std::size_t i = deps.size(); i < explicit_dependencies; i++) {
 			dependencies[i]->remove_dependent(*this);
 		}
-		dependencies.erase(std::begin(deps) + explicit_dependencies,
-						   std::begin(deps) + static_cast<decltype(explicit_dependencies)>(deps.size()));
+		dependencies.erase(std::begin(dependencies) + static_cast<std::ptrdiff_t>(deps.size()),
+						   std::begin(dependencies) + explicit_dependencies);
 		explicit_dependencies = static_cast<decltype(explicit_dependencies)>(deps.size());
 	}
 }
 
+void prop::Property_link::build_dependent_index() const {
+	const auto dependents = get_dependents();
+	dependent_index = std::make_unique<std::unordered_map<const Property_link *, std::uint32_t>>();
+	dependent_index->reserve(std::size(dependents));
+	for (std::uint32_t offset = 0; offset < std::size(dependents); offset++) {
+		dependent_index->emplace(dependents[offset].get_pointer(), offset);
+	}
+}
+
+void prop::Property_link::remove_indexed_dependent(const Property_link &other) const {
+	const auto it = dependent_index->find(&other);
+	if (it == std::end(*dependent_index)) {
+		return;
+	}
+	const auto first_dependent = explicit_dependencies + implicit_dependencies;
+	const auto offset = it->second;
+	dependent_index->erase(it);
+	//the order of dependents does not matter, so fill the gap with the last dependent instead of shifting
+	if (first_dependent + offset != std::size(dependencies) - 1) {
+		auto &gap = dependencies[first_dependent + offset];
+		gap = dependencies.back();
+		(*dependent_index)[gap.get_pointer()] = offset;
+	}
+	dependencies.pop_back();
+	if (std::size(dependencies) - first_dependent < PROP_DEPENDENT_INDEX_THRESHOLD / 2) {
+		dependent_index.reset();
+	}
+}
+
 void prop::Property_link::print_extended_status(const prop::Extended_status_data &esd, int current_depth) const {
 	assert_status();
 	std::string indent;
@@ -534,69 +678,114 @@ void prop::Implicit_dependency_list::read_notify(prop::Required_pointer<Property
 	if (p == current) {
 		return;
 	}
-	const auto is_an_explicit_dependency = [&] {
-		return std::find(std::begin(current->dependencies),
-						 std::begin(current->dependencies) + current->explicit_dependencies,
-						 p) != std::begin(current->dependencies) + current->explicit_dependencies;
-	};
-	const auto is_duplicate_dependency = [&] {
-		return std::find(std::begin(data) + current_index, std::end(data), p) != std::end(data);
-	};
-	if (not is_an_explicit_dependency() and not is_duplicate_dependency()) {
-		data.push_back(p);
-		TRACE("Added      " << p->to_string() << " as an implicit dependency of\n           " << current->to_string());
+	if (epoch) {
+		if (p->capture_epoch == epoch) {
+			return;
+		}
+		stamp(p.get_pointer());
+	} else {
+		//links are shared between threads, so stamps cannot be used to find duplicates
+		const auto is_an_explicit_dependency = [&] {
+			return std::find(std::begin(current->dependencies),
+							 std::begin(current->dependencies) + current->explicit_dependencies,
+							 p) != std::begin(current->dependencies) + current->explicit_dependencies;
+		};
+		const auto is_duplicate_dependency = [&] {
+			return std::find(std::begin(data) + current_index, std::end(data), p) != std::end(data);
+		};
+		if (is_an_explicit_dependency() or is_duplicate_dependency()) {
+			return;
+		}
 	}
+	data.push_back(p);
+	TRACE("Added      " << p->to_string() << " as an implicit dependency of\n           " << current->to_string());
 }
 
 const prop::Update_data prop::Implicit_dependency_list::update_start(Property_link *p) {
 	TRACE("Updating   " << p->get_status());
-	const auto prev_index = current_index;
+	const prop::Update_data update_data{
+		.index = current_index, .saved_stamps = std::size(saved_stamps), .epoch = epoch};
 	data.push_back({p, false});
 	current_index = data.size();
-	return {.index = prev_index};
+	epoch = Propagation_list::in_parallel_phase ? 0 : ++last_epoch;
+	if (epoch) {
+		for (std::size_t i = 0; i < p->explicit_dependencies; i++) {
+			if (auto dependency = p->dependencies[i].get_pointer(); dependency and dependency->capture_epoch != epoch) {
+				stamp(dependency);
+			}
+		}
+	}
+	return update_data;
 }
 
 void prop::Implicit_dependency_list::update_end(const prop::Update_data &update_data) {
 	const auto current = current_binding();
 	assert(current);
+	auto lock = Propagation_list::lock_links();
 
 	const auto new_implicit_dependencies = std::size(data) - current_index;
+	const auto old_begin = std::begin(current->dependencies) + current->explicit_dependencies;
+	const auto old_end = old_begin + current->implicit_dependencies;
+	const auto new_begin = std::begin(data) + current_index;
+	const auto new_end = std::end(data);
 
-	//overwrite overlap
-	const auto overlap_size = std::min<std::size_t>(current->implicit_dependencies, new_implicit_dependencies);
-	for (std::size_t i = 0; i < overlap_size; i++) {
-		auto &old = current->dependencies[i + current->explicit_dependencies];
-		auto &now = data[current_index + i];
-		if (old.get_pointer() != now.get_pointer()) {
-			old->remove_dependent(*current);
-			old = now;
-			old->add_dependent(*current);
-		}
-		old.set_required(now.is_required());
-	}
-
-	if (new_implicit_dependencies > current->implicit_dependencies) {
-		//insert additional dependencies
-		for (auto it = std::begin(data) + current_index + current->implicit_dependencies; it != std::end(data); ++it) {
-			it->get_pointer()->add_dependent(*current);
-		}
-		current->dependencies.insert(std::begin(current->dependencies) + current->explicit_dependencies +
-										 current->implicit_dependencies,
-									 std::begin(data) + current_index + current->implicit_dependencies, std::end(data));
-	} else if (new_implicit_dependencies < current->implicit_dependencies) {
-		//remove extra dependencies
-		const auto from =
-			std::begin(current->dependencies) + current->explicit_dependencies + new_implicit_dependencies;
-		const auto to =
-			std::begin(current->dependencies) + current->explicit_dependencies + current->implicit_dependencies;
-		for (auto it = from; it < to; ++it) {
-			it->get_pointer()->remove_dependent(*current);
-		}
-		current->dependencies.erase(from, to);
+	//only links that left or joined the implicit dependencies change their dependents, no matter the order of reads
+	if (epoch) {
+		//captured links carry the epoch and were stamped by this binding, so their stamps are restored below
+		const auto captured = ++last_epoch;
+		const auto kept = ++last_epoch;
+		for (auto it = new_begin; it != new_end; ++it) {
+			it->get_pointer()->capture_epoch = captured;
+		}
+		for (auto it = old_begin; it != old_end; ++it) {
+			if (it->get_pointer()->capture_epoch == captured) {
+				it->get_pointer()->capture_epoch = kept;
+			} else {
+				it->get_pointer()->remove_dependent(*current);
+			}
+		}
+		for (auto it = new_begin; it != new_end; ++it) {
+			if (it->get_pointer()->capture_epoch != kept) {
+				it->get_pointer()->add_dependent(*current);
+			}
+		}
+	} else {
+		//links are shared between threads, so compare sorted copies instead of stamping
+		std::vector<Property_link *> old_links;
+		std::vector<Property_link *> new_links;
+		const auto to_pointer = [](const Property_link::Property_pointer &link) { return link.get_pointer(); };
+		std::transform(old_begin, old_end, std::back_inserter(old_links), to_pointer);
+		std::transform(new_begin, new_end, std::back_inserter(new_links), to_pointer);
+		std::sort(std::begin(old_links), std::end(old_links));
+		std::sort(std::begin(new_links), std::end(new_links));
+		std::vector<Property_link *> changed_links;
+		std::set_difference(std::begin(old_links), std::end(old_links), std::begin(new_links), std::end(new_links),
+							std::back_inserter(changed_links));
+		for (auto link : changed_links) {
+			link->remove_dependent(*current);
+		}
+		changed_links.clear();
+		std::set_difference(std::begin(new_links), std::end(new_links), std::begin(old_links), std::end(old_links),
+							std::back_inserter(changed_links));
+		for (auto link : changed_links) {
+			link->add_dependent(*current);
+		}
 	}
+	//keeps the order of reads and takes over whether each dependency is required
+	current->dependencies.erase(old_begin, old_end);
+	current->dependencies.insert(std::begin(current->dependencies) + current->explicit_dependencies, new_begin,
+								 new_end);
 	current->implicit_dependencies = new_implicit_dependencies;
 	data.resize(current_index - 1, {nullptr, false});
 	current_index = update_data.index;
+	//restoring in reverse leaves the links read by an enclosing binding stamped with its epoch again
+	while (std::size(saved_stamps) > update_data.saved_stamps) {
+		if (const auto &saved = saved_stamps.back(); saved.link) {
+			saved.link->capture_epoch = saved.epoch;
+		}
+		saved_stamps.pop_back();
+	}
+	epoch = update_data.epoch;
 	TRACE("Updated    " << current->get_status());
 }
 
@@ -611,6 +800,14 @@ void prop::Implicit_dependency_list::remove(Property_link *p) {
 	if (data.empty()) {
 		return;
 	}
+	//stamps are only non-zero while a binding that captured the link is running
+	if (p->capture_epoch) {
+		for (auto &saved : saved_stamps) {
+			if (saved.link == p) {
+				saved.link = nullptr;
+			}
+		}
+	}
 	for (std::size_t i = current_index; i < std::size(data); ++i) {
 		if (data[i] == p) {
 			data.erase(std::begin(data) + i);
@@ -619,3 +816,361 @@ void prop::Implicit_dependency_list::remove(Property_link *p) {
 		}
 	}
 }
+
+void prop::Implicit_dependency_list::stamp(Property_link *p) {
+	saved_stamps.push_back({.link = p, .epoch = p->capture_epoch});
+	p->capture_epoch = epoch;
+}
+
+void prop::Propagation_list::schedule_dependents_of(const Property_link *p, bool written) {
+	if (parent) {
+		parent->schedule_dependents_of(p, written);
+		return;
+	}
+	auto lock = lock_links();
+	for (std::size_t i = p->explicit_dependencies + p->implicit_dependencies; i < std::size(p->dependencies); i++) {
+		if (written and p->dependencies[i]) {
+			p->dependencies[i]->input_written = true;
+		}
+		schedule(p->dependencies[i]);
+	}
+}
+
+void prop::Propagation_list::schedule(Property_link *p) {
+	if (p == nullptr or p == Property_link::binding_data.current_binding()) {
+		return;
+	}
+	if (not running) {
+		seeds.push_back(p);
+		return;
+	}
+	const auto index = p->propagation_index;
+	if (index != Property_link::no_propagation_index) {
+		if (index > current_index) {
+			entries[index].pending = true;
+			return;
+		}
+		//already updated in this propagation, update it again after everything that is currently scheduled
+		entries[index].link = nullptr;
+	}
+	p->propagation_index = static_cast<std::uint32_t>(std::size(entries));
+	entries.push_back({.link = p, .pending = true});
+}
+
+void prop::Propagation_list::collect(Property_link *p) {
+	if (p->propagation_index != Property_link::no_propagation_index) {
+		return;
+	}
+	p->propagation_index = Property_link::collecting_propagation_index;
+	collect_stack.push_back({.link = p, .next_dependent = 0u + p->explicit_dependencies + p->implicit_dependencies});
+	while (not collect_stack.empty()) {
+		auto &frame = collect_stack.back();
+		if (frame.next_dependent == std::size(frame.link->dependencies)) {
+			entries.push_back({.link = frame.link, .pending = false});
+			collect_stack.pop_back();
+			continue;
+		}
+		Property_link *dependent = frame.link->dependencies[frame.next_dependent++];
+		if (dependent and dependent->propagation_index == Property_link::no_propagation_index) {
+			dependent->propagation_index = Property_link::collecting_propagation_index;
+			collect_stack.push_back(
+				{.link = dependent,
+				 .next_dependent = 0u + dependent->explicit_dependencies + dependent->implicit_dependencies});
+		}
+	}
+}
+
+void prop::Propagation_list::run() {
+	assert(not running);
+	prop::detail::RAII cleanup{[this] {
+		for (auto &entry : entries) {
+			if (entry.link) {
+				entry.link->propagation_index = Property_link::no_propagation_index;
+			}
+		}
+		entries.clear();
+		seeds.clear();
+		current_index = 0;
+		levelled_entries = 0;
+		running = false;
+	}};
+	running = true;
+	//reverse post-order of a depth-first search over the dependents is a topological order
+	for (auto seed : seeds) {
+		collect(seed);
+	}
+	std::reverse(std::begin(entries), std::end(entries));
+	for (std::size_t i = 0; i < std::size(entries); i++) {
+		entries[i].link->propagation_index = static_cast<std::uint32_t>(i);
+	}
+	if (parallel_settings.enabled) {
+		assign_levels();
+	}
+	for (auto seed : seeds) {
+		entries[seed->propagation_index].pending = true;
+	}
+	TRACE("Propagating to " << std::size(entries) << " dependents");
+	std::size_t level_end = 0;
+	for (current_index = 0; current_index < std::size(entries); current_index++) {
+		if (current_index >= level_end and current_index < levelled_entries) {
+			for (level_end = current_index + 1;
+				 level_end < levelled_entries and entries[level_end].level == entries[current_index].level;
+				 level_end++) {
+			}
+			if (update_in_parallel(current_index, level_end)) {
+				current_index = level_end - 1;
+				continue;
+			}
+		}
+		auto &entry = entries[current_index];
+		if (not entry.link or not entry.pending) {
+			continue;
+		}
+		entry.pending = false;
+		entry.link->invalidate();
+	}
+}
+
+void prop::Propagation_list::assign_levels() {
+	//a property's level is the length of the longest path to it from the written properties, so properties of the same
+	//level do not depend on each other and can be updated in any order
+	for (auto &entry : entries) {
+		entry.level = 0;
+		for (const auto &dependency : entry.link->get_dependencies()) {
+			if (dependency and dependency->propagation_index < std::size(entries)) {
+				entry.level = std::max(entry.level, entries[dependency->propagation_index].level + 1);
+			}
+		}
+	}
+	std::stable_sort(std::begin(entries), std::end(entries),
+					 [](const Entry &lhs, const Entry &rhs) { return lhs.level < rhs.level; });
+	for (std::size_t i = 0; i < std::size(entries); i++) {
+		entries[i].link->propagation_index = static_cast<std::uint32_t>(i);
+	}
+	levelled_entries = std::size(entries);
+}
+
+namespace {
+	//runs the same job on multiple threads at once, threads are kept alive between jobs
+	class Worker_pool {
+		public:
+		Worker_pool() = default;
+		Worker_pool(const Worker_pool &) = delete;
+		~Worker_pool() {
+			{
+				std::scoped_lock lock{mutex};
+				stopping = true;
+			}
+			wake.notify_all();
+		}
+		void run(unsigned int thread_count, const std::function<void()> &new_job) {
+			while (std::size(threads) + 1 < thread_count) {
+				threads.emplace_back(
+					[this, index = std::size(threads), current_generation = generation] { work(index, current_generation); });
+			}
+			{
+				std::scoped_lock lock{mutex};
+				job = &new_job;
+				participants = thread_count - 1;
+				active = participants;
+				generation++;
+			}
+			wake.notify_all();
+			new_job();
+			std::unique_lock lock{mutex};
+			done.wait(lock, [this] { return active == 0; });
+			job = nullptr;
+		}
+
+		private:
+		void work(std::size_t index, std::size_t seen_generation) {
+			std::unique_lock lock{mutex};
+			while (true) {
+				wake.wait(lock, [&] { return stopping or generation != seen_generation; });
+				if (stopping) {
+					return;
+				}
+				seen_generation = generation;
+				if (index >= participants) {
+					continue;
+				}
+				lock.unlock();
+				(*job)();
+				lock.lock();
+				if (--active == 0) {
+					done.notify_one();
+				}
+			}
+		}
+
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable done;
+		const std::function<void()> *job = nullptr;
+		std::size_t generation = 0;
+		std::size_t participants = 0;
+		std::size_t active = 0;
+		bool stopping = false;
+		std::vector<std::jthread> threads; //last member so threads are joined before the rest is destroyed
+	};
+} // namespace
+
+bool prop::Propagation_list::update_in_parallel(std::size_t begin, std::size_t end) {
+	parallel_work.clear();
+	for (auto i = begin; i < end; i++) {
+		if (entries[i].link and entries[i].pending) {
+			parallel_work.push_back(i);
+		}
+	}
+	const auto thread_count = std::min<std::size_t>(
+		parallel_settings.threads ? parallel_settings.threads : std::max(1u, std::thread::hardware_concurrency()),
+		std::size(parallel_work));
+	if (std::size(parallel_work) < std::max<std::size_t>(parallel_settings.minimum_fan_out, 2) or thread_count < 2) {
+		return false;
+	}
+	TRACE("Updating   " << std::size(parallel_work) << " dependents on " << thread_count << " threads");
+	for (auto i : parallel_work) {
+		entries[i].pending = false;
+		//lazy dependencies are refreshed here so the workers don't have to wait for each other to refresh them
+		const auto &link = *entries[i].link;
+		for (std::size_t d = 0; d < 0u + link.explicit_dependencies + link.implicit_dependencies; d++) {
+			if (const auto dependency = link.dependencies[d].get_pointer()) {
+				dependency->refresh_if_stale();
+			}
+		}
+	}
+	//dependents of this level that get scheduled again are updated after everything else
+	current_index = end - 1;
+	std::atomic<std::size_t> next_work = 0;
+	std::exception_ptr exception;
+	const std::function<void()> job = [&] {
+		auto &local = Property_link::propagation;
+		if (&local != this) {
+			local.parent = this;
+		}
+		in_parallel_phase = true;
+		prop::detail::RAII reset{[&local] {
+			local.parent = nullptr;
+			in_parallel_phase = false;
+		}};
+		for (auto work_index = next_work++; work_index < std::size(parallel_work); work_index = next_work++) {
+			try {
+				Property_link *link;
+				{
+					std::scoped_lock lock{link_mutex};
+					link = entries[parallel_work[work_index]].link;
+				}
+				if (link) {
+					link->invalidate();
+				}
+			} catch (...) {
+				std::scoped_lock lock{link_mutex};
+				if (not exception) {
+					exception = std::current_exception();
+				}
+			}
+		}
+	};
+	static thread_local Worker_pool pool;
+	pool.run(static_cast<unsigned int>(thread_count), job);
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+	return true;
+}
+
+std::unique_lock<std::recursive_mutex> prop::Propagation_list::lock_links() {
+	if (not in_parallel_phase) {
+		return {};
+	}
+	auto &local = Property_link::propagation;
+	return std::unique_lock{(local.parent ? local.parent : &local)->link_mutex};
+}
+
+void prop::set_parallel_propagation(const Parallel_propagation_settings &settings) {
+	Propagation_list::parallel_settings = settings;
+}
+
+const prop::Parallel_propagation_settings &prop::get_parallel_propagation() {
+	return Propagation_list::parallel_settings;
+}
+
+bool prop::Propagation_list::is_running() const {
+	return running or parent;
+}
+
+bool prop::Propagation_list::is_batching() const {
+	return batch_depth != 0;
+}
+
+void prop::Propagation_list::begin_batch() {
+	batch_depth++;
+}
+
+void prop::Propagation_list::end_batch() {
+	assert(batch_depth > 0);
+	--batch_depth;
+	flush();
+}
+
+void prop::Propagation_list::end_batch_deferred() {
+	assert(batch_depth > 0);
+	--batch_depth;
+}
+
+void prop::Propagation_list::flush() {
+	if (batch_depth == 0 and not running and not seeds.empty()) {
+		run();
+	}
+}
+
+void prop::Propagation_list::relocate(Property_link *p) {
+	if (parent) {
+		parent->relocate(p);
+		return;
+	}
+	auto lock = lock_links();
+	if (p->propagation_index < std::size(entries)) {
+		entries[p->propagation_index].link = p;
+	}
+}
+
+void prop::Propagation_list::remove(const Property_link *p) {
+	if (parent) {
+		parent->remove(p);
+		return;
+	}
+	auto lock = lock_links();
+	if (p->propagation_index < std::size(entries)) {
+		entries[p->propagation_index].link = nullptr;
+	}
+	std::erase(seeds, p);
+}
+
+prop::Batch::Batch()
+	: uncaught_exceptions{std::uncaught_exceptions()} {
+	Property_link::propagation.begin_batch();
+}
+
+prop::Batch::~Batch() noexcept(false) {
+	if (std::uncaught_exceptions() == uncaught_exceptions) {
+		Property_link::propagation.end_batch();
+		return;
+	}
+	//already unwinding, an exception from updating the dependents would terminate or have to be dropped
+	Property_link::propagation.end_batch_deferred();
+}
+
+void prop::Batch::flush() {
+	Property_link::propagation.flush();
+}
+
+std::recursive_mutex prop::Graph_lock::mutex;
+
+prop::Graph_lock::Graph_lock() {
+	mutex.lock();
+}
+
+prop::Graph_lock::~Graph_lock() {
+	mutex.unlock();
+}
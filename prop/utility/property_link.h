@@ -3,17 +3,34 @@
 #include "color.h"
 #include "property_decls.h"
 #include "required_pointer.h"
+#include "small_vector.h"
 
+#include <atomic>
 #include <cassert>
+#include <concepts>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 #ifdef PROPERTY_NAMES
 #include <string>
 #endif
 
+#ifndef PROP_LINK_INLINE_CAPACITY
+//number of dependencies and dependents a Property_link stores without allocating
+#define PROP_LINK_INLINE_CAPACITY 4
+#endif
+
+#ifndef PROP_DEPENDENT_INDEX_THRESHOLD
+//number of dependents above which a Property_link indexes its dependents in a hash map instead of searching linearly
+#define PROP_DEPENDENT_INDEX_THRESHOLD 32
+#endif
+
 namespace prop {
 	class Property_link;
 	template <class T>
@@ -29,8 +46,13 @@ namespace prop {
 
 	struct Update_data {
 		std::size_t index;
+		std::size_t saved_stamps;
+		std::uint64_t epoch;
 	};
 
+	//eager properties update as soon as a dependency changes, lazy properties only update when they are read
+	enum class Evaluation_mode : std::uint8_t { eager, lazy };
+
 	struct Implicit_dependency_list {
 		void read_notify(const prop::Property_link *p);
 		void read_notify(prop::Required_pointer<prop::Property_link> p);
@@ -41,14 +63,124 @@ namespace prop {
 		int binding_depth() const;
 
 		private:
+		//a link's capture_epoch before the current binding stamped it, restored when the binding ends
+		struct Saved_stamp {
+			prop::Property_link *link;
+			std::uint64_t epoch;
+		};
+		void stamp(prop::Property_link *p);
 		std::vector<prop::Required_pointer<Property_link>> data;
+		std::vector<Saved_stamp> saved_stamps;
 		std::size_t current_index;
+		//links captured by the current binding carry its epoch, 0 if duplicates are found by searching instead
+		std::uint64_t epoch = 0;
+		std::uint64_t last_epoch = 0;
+	};
+
+	struct Parallel_propagation_settings {
+		bool enabled = false;
+		//minimum number of independent dependents that need updating at the same time to update them in parallel
+		std::size_t minimum_fan_out = 16;
+		//number of threads to update on, including the propagating thread, 0 uses std::thread::hardware_concurrency()
+		unsigned int threads = 0;
+	};
+	//Bindings that are updated in parallel must not move or destroy other properties that are updated in the same pass
+	void set_parallel_propagation(const Parallel_propagation_settings &settings);
+	const Parallel_propagation_settings &get_parallel_propagation();
+
+	//Updates the dependents of written properties in topological order so that every dependent is updated at most once
+	//per write and never observes partially updated dependencies
+	struct Propagation_list {
+		//written is false when p only became stale and may still end up with its old value
+		void schedule_dependents_of(const prop::Property_link *p, bool written);
+		void run();
+		bool is_running() const;
+		bool is_batching() const;
+		void begin_batch();
+		void end_batch();
+		//ends a batch without propagating, its updates stay scheduled for the next propagation
+		void end_batch_deferred();
+		//runs the scheduled updates unless a batch or propagation is in progress
+		void flush();
+		void relocate(prop::Property_link *p);
+		void remove(const prop::Property_link *p);
+		//links are shared between the threads of a parallel update, locks the mutex of the propagation they work for while
+		//the calling thread is one of them and returns an empty lock otherwise
+		static std::unique_lock<std::recursive_mutex> lock_links();
+
+		private:
+		struct Entry {
+			prop::Property_link *link;
+			std::uint32_t level;
+			bool pending;
+		};
+		struct Collect_frame {
+			prop::Property_link *link;
+			std::size_t next_dependent;
+		};
+		void schedule(prop::Property_link *p);
+		void collect(prop::Property_link *p);
+		void assign_levels();
+		bool update_in_parallel(std::size_t begin, std::size_t end);
+		std::vector<Entry> entries;
+		std::vector<prop::Property_link *> seeds;
+		std::vector<Collect_frame> collect_stack;
+		std::vector<std::size_t> parallel_work;
+		std::size_t current_index = 0;
+		std::size_t levelled_entries = 0;
+		std::size_t batch_depth = 0;
+		//set on worker threads while they update dependents on behalf of another thread's propagation
+		Propagation_list *parent = nullptr;
+		bool running = false;
+		static inline Parallel_propagation_settings parallel_settings;
+		std::recursive_mutex link_mutex;
+		//set while this thread updates dependents in parallel with other threads
+		static inline thread_local bool in_parallel_phase = false;
+		friend void prop::set_parallel_propagation(const Parallel_propagation_settings &settings);
+		friend const Parallel_propagation_settings &prop::get_parallel_propagation();
+		friend prop::Implicit_dependency_list;
+	};
+
+	//Defers updating dependents until the outermost Batch is destroyed, then updates all of them in one propagation.
+	//A Batch destroyed by an exception does not update the dependents, they are updated by the next propagation, like
+	//the next write with dependents, the end of the next Batch or flush.
+	class Batch {
+		public:
+		Batch();
+		Batch(const Batch &) = delete;
+		Batch &operator=(const Batch &) = delete;
+		~Batch() noexcept(false);
+		//updates the dependents left pending by Batches that were destroyed by an exception, does nothing while a Batch
+		//exists or dependents are being updated
+		static void flush();
+
+		private:
+		int uncaught_exceptions;
+	};
+
+	decltype(auto) batch(std::invocable auto &&f) {
+		prop::Batch _;
+		return std::forward<decltype(f)>(f)();
+	}
+
+	//Properties do no locking of their own. Every thread that accesses properties which are connected to properties
+	//used by another thread must hold a Graph_lock while doing so. Locking is recursive.
+	class Graph_lock {
+		public:
+		Graph_lock();
+		Graph_lock(const Graph_lock &) = delete;
+		Graph_lock &operator=(const Graph_lock &) = delete;
+		~Graph_lock();
+
+		private:
+		static std::recursive_mutex mutex;
 	};
 
 	class Property_link {
 		public:
 		using Property_pointer = prop::Required_pointer<Property_link>;
-		static inline std::ostream *debug_output;
+		using Link_list = prop::Small_vector<Property_pointer, PROP_LINK_INLINE_CAPACITY>;
+		static inline thread_local std::ostream *debug_output;
 		struct Output_setter {
 			Output_setter(std::ostream &os)
 				: prev{debug_output} {
@@ -93,6 +225,9 @@ namespace prop {
 		}
 		bool has_dependency(const Property_link &other) const {
 			assert_status();
+			if (other.dependent_index) {
+				return other.dependent_index->contains(this);
+			}
 			const auto end = std::begin(dependencies) + explicit_dependencies + implicit_dependencies;
 			return std::find(std::begin(dependencies), end, &other) != end;
 		}
@@ -108,6 +243,9 @@ namespace prop {
 		}
 		bool has_dependent(const Property_link &other) const {
 			assert_status();
+			if (dependent_index) {
+				return dependent_index->contains(&other);
+			}
 			return std::find(std::begin(dependencies) + explicit_dependencies + implicit_dependencies,
 							 std::end(dependencies), &other) != std::end(dependencies);
 		}
@@ -116,6 +254,23 @@ namespace prop {
 			return binding_data.current_binding();
 		}
 
+		//changes whenever the value changes and never goes back, a property that still has the version a dependent saw
+		//still has the value the dependent saw
+		std::uint64_t get_version() const {
+			assert_status();
+			return version;
+		}
+
+		void set_evaluation_mode(Evaluation_mode mode);
+		Evaluation_mode get_evaluation_mode() const {
+			assert_status();
+			return evaluation_mode;
+		}
+		bool is_stale() const {
+			assert_status();
+			return stale;
+		}
+
 		std::string to_string() const;
 
 #ifdef PROPERTY_NAMES
@@ -148,20 +303,25 @@ namespace prop {
 
 		void add_explicit_dependency(Property_pointer property) {
 			assert_status();
+			auto lock = Propagation_list::lock_links();
 			dependencies.insert(std::begin(dependencies) + explicit_dependencies++, property);
 			property->add_dependent(*this);
+			inputs_version = 0;
 		}
 		void add_implicit_dependency(Property_pointer property) {
 			assert_status();
+			auto lock = Propagation_list::lock_links();
 			if (not has_dependency(*property)) {
 				dependencies.insert(std::begin(dependencies) + explicit_dependencies + implicit_dependencies++,
 									property);
 				property->add_dependent(*this);
+				inputs_version = 0;
 			}
 		}
 		void set_explicit_dependencies(std::vector<Property_pointer> &&deps);
 		void replace_dependency(const Property_link &old_value, const Property_link &new_value) {
 			assert_status();
+			auto lock = Propagation_list::lock_links();
 			for (auto it = std::begin(dependencies),
 					  end = std::begin(dependencies) + explicit_dependencies + implicit_dependencies;
 				 it != end; ++it) {
@@ -233,14 +393,35 @@ namespace prop {
 #endif
 		}
 		void print_extended_status(const Extended_status_data &esd, int current_depth) const;
+		void build_dependent_index() const;
+		void remove_indexed_dependent(const Property_link &other) const;
+		void notify_dependents(bool written);
+		void invalidate();
+		void refresh() const;
+		//parallel workers may share a stale dependency, so only one of them refreshes it while the others wait
+		void refresh_if_stale() const;
+		//true if none of the dependencies changed since the last update, so updating again would give the same result
+		bool inputs_unchanged() const;
+		bool take_input_written() const;
 		void add_dependent(const Property_link &other) const {
 			assert_status();
-			if (not has_dependent(other)) {
-				dependencies.push_back({&other, false});
+			if (has_dependent(other)) {
+				return;
+			}
+			dependencies.push_back({&other, false});
+			const auto dependent_count = std::size(dependencies) - explicit_dependencies - implicit_dependencies;
+			if (dependent_index) {
+				dependent_index->emplace(&other, static_cast<std::uint32_t>(dependent_count - 1));
+			} else if (dependent_count > PROP_DEPENDENT_INDEX_THRESHOLD) {
+				build_dependent_index();
 			}
 		}
 		void remove_dependent(const Property_link &other) const {
 			assert_status();
+			if (dependent_index) {
+				remove_indexed_dependent(other);
+				return;
+			}
 			for (auto it = std::begin(dependencies) + explicit_dependencies + implicit_dependencies;
 				 it != std::end(dependencies); ++it) {
 				if (*it == &other) {
@@ -260,6 +441,15 @@ namespace prop {
 		}
 		void replace_dependent(const Property_link &old_value, const Property_link &new_value) {
 			assert_status();
+			if (dependent_index) {
+				auto node = dependent_index->extract(&old_value);
+				if (not node.empty()) {
+					dependencies[explicit_dependencies + implicit_dependencies + node.mapped()] = &new_value;
+					node.key() = &new_value;
+					dependent_index->insert(std::move(node));
+				}
+				return;
+			}
 			for (std::size_t dependent_index = explicit_dependencies + implicit_dependencies;
 				 dependent_index < std::size(dependencies); ++dependent_index) {
 				if (dependencies[dependent_index] == &old_value) {
@@ -272,13 +462,36 @@ namespace prop {
 		std::string to_string(std::string_view type_name) const;
 
 		public:
-		mutable std::vector<Property_pointer> dependencies;
+		mutable Link_list dependencies;
 
 		mutable std::uint16_t explicit_dependencies = 0;
 		mutable std::uint16_t implicit_dependencies = 0;
 
 		private:
-		static inline Implicit_dependency_list binding_data;
+		static constexpr std::uint32_t no_propagation_index = std::numeric_limits<std::uint32_t>::max();
+		static constexpr std::uint32_t collecting_propagation_index = no_propagation_index - 1;
+		mutable std::uint32_t propagation_index = no_propagation_index;
+		//epoch of the binding that last captured this link, belongs to the address and is not moved or swapped
+		mutable std::uint64_t capture_epoch = 0;
+		Evaluation_mode evaluation_mode = Evaluation_mode::eager;
+		//atomic so reads of refreshed links don't need to lock while other threads may refresh them
+		mutable std::atomic<bool> stale = false;
+		mutable bool refreshing = false;
+		//a dependency was written since the last update, so checking whether the inputs changed can be skipped
+		mutable bool input_written = false;
+		//maps dependents to their offset from the first dependent, only exists for properties with many dependents
+		mutable std::unique_ptr<std::unordered_map<const Property_link *, std::uint32_t>> dependent_index;
+
+		//versions are unique across all properties, so moved or swapped values never reuse a version of another value
+		static std::uint64_t next_version();
+		static inline std::atomic<std::uint64_t> last_version;
+		std::uint64_t version = next_version();
+		//highest version any property had when the last update started, 0 if the dependencies changed since
+		std::uint64_t inputs_version = 0;
+
+		//each thread evaluates its own bindings and propagates its own writes
+		static inline thread_local Implicit_dependency_list binding_data;
+		static inline thread_local Propagation_list propagation;
 		template <class T>
 			requires(std::is_convertible_v<T *, prop::Property_link *>)
 		friend class Tracking_list;
@@ -290,6 +503,8 @@ namespace prop {
 																				  std::index_sequence<indexes...>);
 
 		friend prop::Implicit_dependency_list;
+		friend prop::Propagation_list;
+		friend prop::Batch;
 	};
 	inline void Property_link::update() {
 		assert_status();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <ostream>
@@ -76,6 +77,47 @@ namespace prop {
 		}
 	};
 
+	template <class T>
+	constexpr bool is_empty(const Rect<T> &rect) {
+		return rect.right <= rect.left or rect.bottom <= rect.top;
+	}
+
+	template <class T>
+	constexpr bool intersects(const Rect<T> &lhs, const Rect<T> &rhs) {
+		return lhs.left < rhs.right and rhs.left < lhs.right and lhs.top < rhs.bottom and rhs.top < lhs.bottom;
+	}
+
+	//area covered by both rects, an empty rect if they do not intersect
+	template <class T>
+	constexpr Rect<T> intersected(const Rect<T> &lhs, const Rect<T> &rhs) {
+		if (not intersects(lhs, rhs)) {
+			return {};
+		}
+		return {
+			.top = std::max(lhs.top, rhs.top),
+			.left = std::max(lhs.left, rhs.left),
+			.bottom = std::min(lhs.bottom, rhs.bottom),
+			.right = std::min(lhs.right, rhs.right),
+		};
+	}
+
+	//smallest rect that contains both rects, empty rects are ignored
+	template <class T>
+	constexpr Rect<T> united(const Rect<T> &lhs, const Rect<T> &rhs) {
+		if (is_empty(lhs)) {
+			return rhs;
+		}
+		if (is_empty(rhs)) {
+			return lhs;
+		}
+		return {
+			.top = std::min(lhs.top, rhs.top),
+			.left = std::min(lhs.left, rhs.left),
+			.bottom = std::max(lhs.bottom, rhs.bottom),
+			.right = std::max(lhs.right, rhs.right),
+		};
+	}
+
 	template <class T>
 	std::ostream &operator<<(std::ostream &os, const Rect<T> &rect) {
 		return os << "{.top=" << rect.top << ", .left=" << rect.left << ", .bottom=" << rect.bottom
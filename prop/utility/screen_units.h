@@ -35,7 +35,10 @@ namespace prop {
 	};
 	inline prop::Property<prop::platform::Get_screens_strategy> get_screens_strategy =
 		prop::platform::Get_screens_strategy::compatibility;
+	//incremented when the platform reports that the screens changed
+	inline prop::Property<std::size_t> screens_version = 0;
 	const inline prop::Property<std::vector<prop::platform::Screen>> screens = [] {
+		screens_version.get();
 		return prop::platform::get_screens(get_screens_strategy);
 	};
 
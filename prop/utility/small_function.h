@@ -0,0 +1,155 @@
+#pragma once
+
+#include "arena.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace prop {
+	template <class Signature, std::size_t buffer_size>
+	class Small_function;
+
+	//Move-only function like std::move_only_function, but callables of up to buffer_size bytes are stored inside of it
+	//instead of being allocated. Larger callables and callables that may throw when moved are allocated from the
+	//prop::current_memory_resource() at the time the Small_function was created. Moving an allocated callable into a
+	//Small_function created with another resource moves it into that resource.
+	template <class R, class... Args, std::size_t buffer_size>
+	class Small_function<R(Args...), buffer_size> {
+		public:
+		Small_function() = default;
+		Small_function(std::nullptr_t) {}
+		template <class F>
+			requires(not std::is_same_v<std::remove_cvref_t<F>, Small_function> and
+					 std::is_invocable_r_v<R, std::decay_t<F> &, Args...>)
+		Small_function(F &&f) {
+			using Callable = std::decay_t<F>;
+			if constexpr (std::is_pointer_v<Callable> or std::is_member_pointer_v<Callable>) {
+				if (f == nullptr) {
+					return;
+				}
+			}
+			if constexpr (stored_inline<Callable>) {
+				::new (static_cast<void *>(buffer)) Callable(std::forward<F>(f));
+				operations = &inline_operations<Callable>;
+			} else {
+				auto storage = prop::detail::allocate_tracked(resource, sizeof(Callable), alignof(Callable));
+				try {
+					::new (static_cast<void *>(buffer)) Callable *(::new (storage) Callable(std::forward<F>(f)));
+				} catch (...) {
+					prop::detail::deallocate_tracked(storage, sizeof(Callable), alignof(Callable));
+					throw;
+				}
+				operations = &allocated_operations<Callable>;
+			}
+		}
+		Small_function(const Small_function &) = delete;
+		Small_function(Small_function &&other) noexcept {
+			take(other);
+		}
+		Small_function &operator=(const Small_function &) = delete;
+		Small_function &operator=(Small_function &&other) noexcept {
+			if (this != &other) {
+				reset();
+				take(other);
+			}
+			return *this;
+		}
+		Small_function &operator=(std::nullptr_t) noexcept {
+			reset();
+			return *this;
+		}
+		~Small_function() {
+			reset();
+		}
+
+		R operator()(Args... args) {
+			return operations->invoke(buffer, std::forward<Args>(args)...);
+		}
+		explicit operator bool() const {
+			return operations != nullptr;
+		}
+		friend bool operator==(const Small_function &f, std::nullptr_t) {
+			return not f;
+		}
+
+		private:
+		struct Operations {
+			R (*invoke)(void *storage, Args &&...args);
+			//move constructs the callable into to and destroys the one in from
+			void (*relocate)(void *from, void *to) noexcept;
+			void (*destroy)(void *storage) noexcept;
+			//moves an allocated callable into memory from resource, terminates if that throws, nullptr for inline callables
+			void (*rehome)(void *storage, std::pmr::memory_resource *resource) noexcept;
+		};
+
+		template <class Callable>
+		static constexpr bool stored_inline = sizeof(Callable) <= buffer_size and
+											  alignof(Callable) <= alignof(std::max_align_t) and
+											  std::is_nothrow_move_constructible_v<Callable>;
+
+		template <class Callable>
+		static constexpr Operations inline_operations{
+			.invoke = [](void *storage, Args &&...args) -> R {
+				return std::invoke_r<R>(*std::launder(static_cast<Callable *>(storage)), std::forward<Args>(args)...);
+			},
+			.relocate =
+				[](void *from, void *to) noexcept {
+					auto &callable = *std::launder(static_cast<Callable *>(from));
+					::new (to) Callable(std::move(callable));
+					callable.~Callable();
+				},
+			.destroy = [](void *storage) noexcept { std::launder(static_cast<Callable *>(storage))->~Callable(); },
+			.rehome = nullptr,
+		};
+
+		template <class Callable>
+		static constexpr Operations allocated_operations{
+			.invoke = [](void *storage, Args &&...args) -> R {
+				return std::invoke_r<R>(**std::launder(static_cast<Callable **>(storage)), std::forward<Args>(args)...);
+			},
+			.relocate = [](void *from,
+						   void *to) noexcept { ::new (to) Callable *(*std::launder(static_cast<Callable **>(from))); },
+			.destroy =
+				[](void *storage) noexcept {
+					auto callable = *std::launder(static_cast<Callable **>(storage));
+					std::destroy_at(callable);
+					prop::detail::deallocate_tracked(callable, sizeof(Callable), alignof(Callable));
+				},
+			.rehome =
+				[](void *storage, std::pmr::memory_resource *resource) noexcept {
+					auto &callable = *std::launder(static_cast<Callable **>(storage));
+					if (prop::detail::tracked_resource(callable) == resource) {
+						return;
+					}
+					auto new_storage = prop::detail::allocate_tracked(resource, sizeof(Callable), alignof(Callable));
+					auto moved = ::new (new_storage) Callable(std::move(*callable));
+					std::destroy_at(callable);
+					prop::detail::deallocate_tracked(callable, sizeof(Callable), alignof(Callable));
+					callable = moved;
+				},
+		};
+
+		void take(Small_function &other) noexcept {
+			if (other.operations) {
+				other.operations->relocate(other.buffer, buffer);
+				operations = std::exchange(other.operations, nullptr);
+				if (operations->rehome) {
+					operations->rehome(buffer, resource);
+				}
+			}
+		}
+		void reset() noexcept {
+			if (operations) {
+				std::exchange(operations, nullptr)->destroy(buffer);
+			}
+		}
+
+		std::pmr::memory_resource *resource = prop::current_memory_resource();
+		const Operations *operations = nullptr;
+		alignas(std::max_align_t) std::byte buffer[buffer_size < sizeof(void *) ? sizeof(void *) : buffer_size];
+	};
+} // namespace prop
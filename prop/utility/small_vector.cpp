@@ -0,0 +1 @@
+#include "small_vector.h"
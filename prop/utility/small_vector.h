@@ -0,0 +1,229 @@
+#pragma once
+
+#include "arena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace prop {
+	//Vector that keeps up to inline_capacity elements inside of itself and only allocates when it grows beyond that.
+	//Elements are relocated with memcpy, so only trivially copyable types are supported.
+	//Allocations come from the prop::current_memory_resource() at the time the vector was created.
+	template <class T, std::size_t inline_capacity>
+		requires(std::is_trivially_copyable_v<T> and inline_capacity > 0)
+	class Small_vector {
+		public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T &;
+		using const_reference = const T &;
+		using pointer = T *;
+		using const_pointer = const T *;
+		using iterator = T *;
+		using const_iterator = const T *;
+
+		Small_vector() = default;
+		Small_vector(std::initializer_list<T> list)
+			: Small_vector(std::begin(list), std::end(list)) {}
+		template <std::forward_iterator Iterator>
+		Small_vector(Iterator first, Iterator last) {
+			insert(end(), first, last);
+		}
+		Small_vector(const Small_vector &other)
+			: Small_vector(other.begin(), other.end()) {}
+		Small_vector(Small_vector &&other) noexcept {
+			steal(other);
+		}
+		Small_vector &operator=(const Small_vector &other) {
+			if (this != &other) {
+				assign(other.begin(), other.end());
+			}
+			return *this;
+		}
+		Small_vector &operator=(Small_vector &&other) noexcept {
+			if (this != &other) {
+				deallocate();
+				steal(other);
+			}
+			return *this;
+		}
+		~Small_vector() {
+			deallocate();
+		}
+
+		iterator begin() {
+			return elements;
+		}
+		const_iterator begin() const {
+			return elements;
+		}
+		iterator end() {
+			return elements + count;
+		}
+		const_iterator end() const {
+			return elements + count;
+		}
+		T *data() {
+			return elements;
+		}
+		const T *data() const {
+			return elements;
+		}
+		std::size_t size() const {
+			return count;
+		}
+		bool empty() const {
+			return count == 0;
+		}
+		std::size_t capacity() const {
+			return allocated;
+		}
+		bool is_inline() const {
+			return elements == inline_data();
+		}
+		T &operator[](std::size_t index) {
+			assert(index < count);
+			return elements[index];
+		}
+		const T &operator[](std::size_t index) const {
+			assert(index < count);
+			return elements[index];
+		}
+		T &front() {
+			return (*this)[0];
+		}
+		const T &front() const {
+			return (*this)[0];
+		}
+		T &back() {
+			return (*this)[count - 1];
+		}
+		const T &back() const {
+			return (*this)[count - 1];
+		}
+
+		void reserve(std::size_t new_capacity) {
+			if (new_capacity <= allocated) {
+				return;
+			}
+			T *new_elements =
+				static_cast<T *>(prop::detail::allocate_tracked(resource, new_capacity * sizeof(T), alignof(T)));
+			if (count) {
+				std::memcpy(static_cast<void *>(new_elements), elements, count * sizeof(T));
+			}
+			deallocate();
+			elements = new_elements;
+			allocated = static_cast<std::uint32_t>(new_capacity);
+		}
+		void push_back(const T &value) {
+			insert(end(), value);
+		}
+		iterator insert(const_iterator pos, const T &value) {
+			const auto index = static_cast<std::size_t>(pos - begin());
+			assert(index <= count);
+			const T copy = value; //value may be an element of this vector
+			grow_to(count + 1);
+			std::memmove(static_cast<void *>(elements + index + 1), elements + index, (count - index) * sizeof(T));
+			std::construct_at(elements + index, copy);
+			count++;
+			return elements + index;
+		}
+		template <std::forward_iterator Iterator>
+		iterator insert(const_iterator pos, Iterator first, Iterator last) {
+			const auto index = static_cast<std::size_t>(pos - begin());
+			assert(index <= count);
+			const auto inserted = static_cast<std::size_t>(std::distance(first, last));
+			grow_to(count + inserted);
+			std::memmove(static_cast<void *>(elements + index + inserted), elements + index,
+						 (count - index) * sizeof(T));
+			std::uninitialized_copy(first, last, elements + index);
+			count += static_cast<std::uint32_t>(inserted);
+			return elements + index;
+		}
+		template <std::forward_iterator Iterator>
+		void assign(Iterator first, Iterator last) {
+			clear();
+			insert(end(), first, last);
+		}
+		iterator erase(const_iterator pos) {
+			return erase(pos, pos + 1);
+		}
+		iterator erase(const_iterator first, const_iterator last) {
+			const auto index = static_cast<std::size_t>(first - begin());
+			const auto erased = static_cast<std::size_t>(last - first);
+			assert(index + erased <= count);
+			std::memmove(static_cast<void *>(elements + index), elements + index + erased,
+						 (count - index - erased) * sizeof(T));
+			count -= static_cast<std::uint32_t>(erased);
+			return elements + index;
+		}
+		void pop_back() {
+			assert(count > 0);
+			count--;
+		}
+		void clear() {
+			count = 0;
+		}
+
+		friend bool operator==(const Small_vector &lhs, const Small_vector &rhs) {
+			return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+
+		private:
+		T *inline_data() {
+			return reinterpret_cast<T *>(inline_storage);
+		}
+		const T *inline_data() const {
+			return reinterpret_cast<const T *>(inline_storage);
+		}
+		void grow_to(std::size_t minimum_capacity) {
+			if (minimum_capacity > allocated) {
+				reserve(std::max<std::size_t>(minimum_capacity, 2 * allocated));
+			}
+		}
+		void deallocate() {
+			if (not is_inline()) {
+				prop::detail::deallocate_tracked(elements, allocated * sizeof(T), alignof(T));
+			}
+		}
+		void steal(Small_vector &other) {
+			if (not other.is_inline() and prop::detail::tracked_resource(other.elements) != resource) {
+				//the memory of other may not live as long as this vector, so the elements are copied into our own resource
+				elements = inline_data();
+				allocated = inline_capacity;
+				count = 0;
+				insert(end(), other.begin(), other.end());
+				other.clear();
+				return;
+			}
+			if (other.is_inline()) {
+				elements = inline_data();
+				allocated = inline_capacity;
+				if (other.count) {
+					std::memcpy(static_cast<void *>(elements), other.elements, other.count * sizeof(T));
+				}
+			} else {
+				elements = other.elements;
+				allocated = other.allocated;
+				other.elements = other.inline_data();
+				other.allocated = inline_capacity;
+			}
+			count = other.count;
+			other.count = 0;
+		}
+
+		std::pmr::memory_resource *resource = prop::current_memory_resource();
+		T *elements = inline_data();
+		std::uint32_t count = 0;
+		std::uint32_t allocated = inline_capacity;
+		alignas(T) std::byte inline_storage[inline_capacity * sizeof(T)];
+	};
+} // namespace prop
@@ -0,0 +1,130 @@
+#include "text_measurement.h"
+#include "prop/platform/platform.h"
+
+static std::uint8_t font_style(const prop::Font &font) {
+	return static_cast<std::uint8_t>(font.bold << 0 | font.italic << 1 | font.strikeout << 2 | font.underline << 3);
+}
+
+static prop::Size<> measure_with_platform(std::string_view text, const prop::Font &font) {
+	return prop::platform::canvas::text_size(text, font);
+}
+
+std::size_t prop::Text_measurement_cache::Key_hash::operator()(const Key &key) const {
+	auto hash = std::hash<std::string_view>{}(key.text);
+	const auto combine = [&hash](std::size_t value) { hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2); };
+	combine(std::hash<std::string_view>{}(key.font_name));
+	combine(std::hash<prop::Screen_unit_precision>{}(key.font_size));
+	combine(key.font_style);
+	return hash;
+}
+
+prop::Text_measurement_cache::Key prop::Text_measurement_cache::Entry::key() const {
+	return {.text = text, .font_name = font_name, .font_size = font_size, .font_style = font_style};
+}
+
+prop::Text_measurement_cache::Text_measurement_cache(std::size_t capacity_)
+	: Text_measurement_cache{capacity_, measure_with_platform} {}
+
+prop::Text_measurement_cache::Text_measurement_cache(std::size_t capacity_, Measure_function measure_function_)
+	: capacity{capacity_}
+	, measure_function{std::move(measure_function_)} {}
+
+prop::Size<> prop::Text_measurement_cache::measure(std::string_view text, const prop::Font &font) {
+	std::lock_guard lock{mutex};
+	return lookup(text, font);
+}
+
+std::vector<prop::Size<>> prop::Text_measurement_cache::measure(std::span<const std::string_view> texts,
+																 const prop::Font &font) {
+	std::vector<prop::Size<>> sizes;
+	sizes.reserve(std::size(texts));
+	std::lock_guard lock{mutex};
+	for (auto text : texts) {
+		sizes.push_back(lookup(text, font));
+	}
+	return sizes;
+}
+
+std::vector<prop::Size<>> prop::Text_measurement_cache::measure(std::span<const std::string> texts,
+																 const prop::Font &font) {
+	std::vector<prop::Size<>> sizes;
+	sizes.reserve(std::size(texts));
+	std::lock_guard lock{mutex};
+	for (auto &text : texts) {
+		sizes.push_back(lookup(text, font));
+	}
+	return sizes;
+}
+
+prop::Text_measurement_cache::Statistics prop::Text_measurement_cache::get_statistics() const {
+	std::lock_guard lock{mutex};
+	return statistics;
+}
+
+void prop::Text_measurement_cache::reset_statistics() {
+	std::lock_guard lock{mutex};
+	statistics = {};
+}
+
+std::size_t prop::Text_measurement_cache::size() const {
+	std::lock_guard lock{mutex};
+	return std::size(entries);
+}
+
+std::size_t prop::Text_measurement_cache::get_capacity() const {
+	std::lock_guard lock{mutex};
+	return capacity;
+}
+
+void prop::Text_measurement_cache::set_capacity(std::size_t capacity_) {
+	std::lock_guard lock{mutex};
+	capacity = capacity_;
+	evict_to(capacity);
+}
+
+void prop::Text_measurement_cache::clear() {
+	std::lock_guard lock{mutex};
+	index.clear();
+	entries.clear();
+}
+
+prop::Text_measurement_cache &prop::Text_measurement_cache::global() {
+	static Text_measurement_cache cache;
+	return cache;
+}
+
+prop::Size<> prop::Text_measurement_cache::lookup(std::string_view text, const prop::Font &font) {
+	const Key key{.text = text, .font_name = font.name, .font_size = font.size.amount, .font_style = font_style(font)};
+	if (auto it = index.find(key); it != std::end(index)) {
+		statistics.hits++;
+		entries.splice(std::begin(entries), entries, it->second);
+		return it->second->size;
+	}
+	statistics.misses++;
+	const auto size = measure_function(text, font);
+	if (capacity == 0) {
+		return size;
+	}
+	evict_to(capacity - 1);
+	entries.push_front(Entry{
+		.text = std::string{text},
+		.font_name = font.name,
+		.font_size = key.font_size,
+		.font_style = key.font_style,
+		.size = size,
+	});
+	index.emplace(entries.front().key(), std::begin(entries));
+	return size;
+}
+
+void prop::Text_measurement_cache::evict_to(std::size_t capacity_) {
+	while (std::size(entries) > capacity_) {
+		index.erase(entries.back().key());
+		entries.pop_back();
+		statistics.evictions++;
+	}
+}
+
+prop::Size<> prop::measure_text(std::string_view text, const prop::Font &font) {
+	return prop::Text_measurement_cache::global().measure(text, font);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "prop/utility/font.h"
+#include "prop/utility/rect.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace prop {
+	//Least recently used cache of text sizes in front of prop::platform::canvas::text_size.
+	//Only the font attributes that affect the size of the text (name, size, bold, italic, strikeout, underline) are
+	//part of the key, so the same string in a differently colored font is measured once.
+	class Text_measurement_cache {
+		public:
+		using Measure_function = std::function<prop::Size<>(std::string_view text, const prop::Font &font)>;
+		struct Statistics {
+			std::size_t hits = 0;
+			std::size_t misses = 0;
+			std::size_t evictions = 0;
+		};
+
+		Text_measurement_cache(std::size_t capacity = 4096);
+		Text_measurement_cache(std::size_t capacity, Measure_function measure_function);
+		Text_measurement_cache(const Text_measurement_cache &) = delete;
+		Text_measurement_cache &operator=(const Text_measurement_cache &) = delete;
+
+		prop::Size<> measure(std::string_view text, const prop::Font &font);
+		//measures all texts with a single lock and only calls the measure function for texts that are not cached
+		std::vector<prop::Size<>> measure(std::span<const std::string_view> texts, const prop::Font &font);
+		std::vector<prop::Size<>> measure(std::span<const std::string> texts, const prop::Font &font);
+
+		Statistics get_statistics() const;
+		void reset_statistics();
+		std::size_t size() const;
+		std::size_t get_capacity() const;
+		void set_capacity(std::size_t capacity);
+		void clear();
+
+		//cache used by the widgets
+		static Text_measurement_cache &global();
+
+		private:
+		struct Key {
+			std::string_view text;
+			std::string_view font_name;
+			prop::Screen_unit_precision font_size;
+			std::uint8_t font_style;
+			bool operator==(const Key &) const = default;
+		};
+		struct Key_hash {
+			std::size_t operator()(const Key &key) const;
+		};
+		struct Entry {
+			std::string text;
+			std::string font_name;
+			prop::Screen_unit_precision font_size;
+			std::uint8_t font_style;
+			prop::Size<> size;
+			Key key() const;
+		};
+
+		prop::Size<> lookup(std::string_view text, const prop::Font &font);
+		void evict_to(std::size_t capacity);
+
+		//most recently used entry first, the map keys point into the entries
+		std::list<Entry> entries;
+		std::unordered_map<Key, std::list<Entry>::iterator, Key_hash> index;
+		std::size_t capacity;
+		Measure_function measure_function;
+		Statistics statistics;
+		mutable std::mutex mutex;
+	};
+
+	//measures text through prop::Text_measurement_cache::global()
+	prop::Size<> measure_text(std::string_view text, const prop::Font &font);
+} // namespace prop
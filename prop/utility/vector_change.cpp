@@ -0,0 +1,36 @@
+#include "vector_change.h"
+
+#include <algorithm>
+
+std::size_t prop::first_changed_index(std::span<const Vector_change> changes) {
+	auto first = std::numeric_limits<std::size_t>::max();
+	for (const auto &change : changes) {
+		first = std::min(first, change.type == Vector_change::Type::move ? std::min(change.index, change.to)
+																		  : change.index);
+	}
+	return first;
+}
+
+std::optional<std::span<const prop::Vector_change>>
+prop::Vector_change_log::changes_since(std::uint64_t since_version) const {
+	if (since_version < first_version or since_version > version) {
+		return std::nullopt;
+	}
+	return std::span{changes}.subspan(static_cast<std::size_t>(since_version - first_version));
+}
+
+void prop::Vector_change_log::record(const Vector_change &change) {
+	if (std::size(changes) == PROP_VECTOR_CHANGE_LOG_CAPACITY) {
+		//forget the older half at once so recording stays amortized constant time
+		const auto forgotten = std::size(changes) / 2 + 1;
+		changes.erase(std::begin(changes), std::begin(changes) + static_cast<std::ptrdiff_t>(forgotten));
+		first_version += forgotten;
+	}
+	changes.push_back(change);
+	version++;
+}
+
+void prop::Vector_change_log::reset() {
+	changes.clear();
+	first_version = ++version;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+#ifndef PROP_VECTOR_CHANGE_LOG_CAPACITY
+//number of changes a Property<std::vector<T>> remembers, dependents that fall further behind see all of it as changed
+#define PROP_VECTOR_CHANGE_LOG_CAPACITY 64
+#endif
+
+namespace prop {
+	//Structural change of a Property<std::vector<T>>. Indexes refer to the vector right before the change, except to,
+	//which is the index of a moved element right after the change.
+	struct Vector_change {
+		enum class Type : std::uint8_t { insert, erase, move, update };
+		Type type;
+		std::size_t index;
+		std::size_t count = 1;
+		std::size_t to = 0;
+		auto operator<=>(const Vector_change &) const = default;
+	};
+
+	//smallest index whose element may differ after the changes, elements in front of it stay where they were
+	std::size_t first_changed_index(std::span<const Vector_change> changes);
+
+	class Vector_change_log {
+		public:
+		//a version no log has, dependents that have not seen the vector yet use it to get nullopt from changes_since
+		static constexpr std::uint64_t no_version = std::numeric_limits<std::uint64_t>::max();
+		//increases with every change, including changes that replace the whole vector
+		std::uint64_t get_version() const {
+			return version;
+		}
+		//changes made after version, nullopt if they are not known, e.g. because the whole vector was replaced
+		std::optional<std::span<const Vector_change>> changes_since(std::uint64_t since_version) const;
+		void record(const Vector_change &change);
+		//the whole vector changed, all dependents need to look at all of it
+		void reset();
+
+		private:
+		std::vector<Vector_change> changes;
+		//version before the first change in changes
+		std::uint64_t first_version = 0;
+		std::uint64_t version = 0;
+	};
+} // namespace prop